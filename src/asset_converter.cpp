@@ -1,6 +1,16 @@
 #include "asset_converter.h"
+#include "encoder_thread_budget.h"
+#include "gltf_json.h"
+#include "image_resize.h"
+#include "mapped_file.h"
+#include "output_file.h"
 
+#include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/time.hpp>
 #include <godot_cpp/variant/callable.hpp>
 #include <godot_cpp/variant/callable_method_pointer.hpp>
 
@@ -13,6 +23,9 @@
 // Image loading with stb_image (supports PNG, JPEG, BMP, TGA, GIF, PSD, HDR, PIC)
 #include "stb_image.h"
 
+// OpenEXR decoding (compiled as part of basisu)
+#include "tinyexr.h"
+
 // Audio processing with dr_libs
 #include "dr_wav.h"
 #include "dr_mp3.h"
@@ -23,13 +36,36 @@
 // GLB parsing with cgltf
 #include "cgltf.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 using namespace godot;
 
+// PCM frames read and encoded per step when streaming WAV to MP3
+static const size_t AUDIO_CHUNK_FRAMES = 65536;
+
+// Shortest segment worth encoding on its own thread in parallel MP3 mode
+static const uint64_t MIN_MP3_SEGMENT_SECONDS = 30;
+
+// Workers beyond one per core. Tasks hold encoder threads only while encoding, so these
+// extra workers read and decode the next assets while every core encodes. The same
+// number of read-ahead slots bounds how many tasks can be reading, decoding or holding
+// decoded data before they get encoder threads, whatever the worker count.
+static const int PIPELINE_READAHEAD_WORKERS = 2;
+
+static int default_worker_count() {
+    return OS::get_singleton()->get_processor_count() + PIPELINE_READAHEAD_WORKERS;
+}
+
 void AssetConverter::_bind_methods() {
     // Signals
     ADD_SIGNAL(MethodInfo("conversion_started",
@@ -49,13 +85,28 @@ void AssetConverter::_bind_methods() {
         PropertyInfo(Variant::STRING, "error_message")));
 
     ADD_SIGNAL(MethodInfo("batch_completed",
+        PropertyInfo(Variant::INT, "batch_id"),
         PropertyInfo(Variant::ARRAY, "results")));
 
+    ADD_SIGNAL(MethodInfo("batch_progress",
+        PropertyInfo(Variant::INT, "batch_id"),
+        PropertyInfo(Variant::INT, "done"),
+        PropertyInfo(Variant::INT, "total"),
+        PropertyInfo(Variant::INT, "bytes_in"),
+        PropertyInfo(Variant::INT, "bytes_out"),
+        PropertyInfo(Variant::FLOAT, "eta")));
+
+    // Enums
+    BIND_ENUM_CONSTANT(SCHEDULE_FIFO);
+    BIND_ENUM_CONSTANT(SCHEDULE_LONGEST_FIRST);
+    BIND_ENUM_CONSTANT(SCHEDULE_SHORTEST_FIRST);
+
     // Conversion methods
-    ClassDB::bind_method(D_METHOD("image_to_ktx2", "source_path", "output_path", "quality", "mipmaps"), &AssetConverter::image_to_ktx2, DEFVAL(128), DEFVAL(true));
-    ClassDB::bind_method(D_METHOD("audio_to_mp3", "source_path", "output_path", "bitrate"), &AssetConverter::audio_to_mp3, DEFVAL(192));
-    ClassDB::bind_method(D_METHOD("glb_textures_to_ktx2", "source_path", "output_path", "quality", "mipmaps"), &AssetConverter::glb_textures_to_ktx2, DEFVAL(""), DEFVAL(128), DEFVAL(true));
-    ClassDB::bind_method(D_METHOD("normalize_audio", "source_path", "output_path", "target_db", "peak_limit_db"), &AssetConverter::normalize_audio, DEFVAL(-14.0f), DEFVAL(-1.0f));
+    ClassDB::bind_method(D_METHOD("image_to_ktx2", "source_path", "output_path", "quality", "mipmaps", "encoder", "compression_level", "max_size", "scale", "pow2", "priority"), &AssetConverter::image_to_ktx2, DEFVAL(128), DEFVAL(true), DEFVAL(ConversionTask::ENCODER_UASTC), DEFVAL(2), DEFVAL(0), DEFVAL(1.0f), DEFVAL(false), DEFVAL(ConversionTask::PRIORITY_NORMAL));
+    ClassDB::bind_method(D_METHOD("images_to_ktx2", "source_paths", "output_path", "layout", "quality", "mipmaps", "encoder", "compression_level", "max_size", "scale", "pow2", "priority"), &AssetConverter::images_to_ktx2, DEFVAL(ConversionTask::LAYOUT_2D_ARRAY), DEFVAL(128), DEFVAL(true), DEFVAL(ConversionTask::ENCODER_UASTC), DEFVAL(2), DEFVAL(0), DEFVAL(1.0f), DEFVAL(false), DEFVAL(ConversionTask::PRIORITY_NORMAL));
+    ClassDB::bind_method(D_METHOD("audio_to_mp3", "source_path", "output_path", "bitrate", "parallel_segments", "priority"), &AssetConverter::audio_to_mp3, DEFVAL(192), DEFVAL(false), DEFVAL(ConversionTask::PRIORITY_NORMAL));
+    ClassDB::bind_method(D_METHOD("glb_textures_to_ktx2", "source_path", "output_path", "quality", "mipmaps", "keep_fallback", "encoder", "compression_level", "max_size", "scale", "pow2", "priority"), &AssetConverter::glb_textures_to_ktx2, DEFVAL(""), DEFVAL(128), DEFVAL(true), DEFVAL(false), DEFVAL(ConversionTask::ENCODER_UASTC), DEFVAL(2), DEFVAL(0), DEFVAL(1.0f), DEFVAL(false), DEFVAL(ConversionTask::PRIORITY_NORMAL));
+    ClassDB::bind_method(D_METHOD("normalize_audio", "source_path", "output_path", "target_db", "peak_limit_db", "priority"), &AssetConverter::normalize_audio, DEFVAL(-14.0f), DEFVAL(-1.0f), DEFVAL(ConversionTask::PRIORITY_NORMAL));
 
     // Batch conversion
     ClassDB::bind_method(D_METHOD("convert_batch", "tasks"), &AssetConverter::convert_batch);
@@ -65,52 +116,146 @@ void AssetConverter::_bind_methods() {
     ClassDB::bind_method(D_METHOD("cancel_all"), &AssetConverter::cancel_all);
     ClassDB::bind_method(D_METHOD("is_running"), &AssetConverter::is_running);
     ClassDB::bind_method(D_METHOD("get_pending_count"), &AssetConverter::get_pending_count);
+    ClassDB::bind_method(D_METHOD("get_queue_wait_stats"), &AssetConverter::get_queue_wait_stats);
+    ClassDB::bind_method(D_METHOD("reset_queue_wait_stats"), &AssetConverter::reset_queue_wait_stats);
+
+    // Worker pool configuration
+    ClassDB::bind_method(D_METHOD("set_worker_count", "count"), &AssetConverter::set_worker_count);
+    ClassDB::bind_method(D_METHOD("get_worker_count"), &AssetConverter::get_worker_count);
+
+    ClassDB::bind_static_method("AssetConverter", D_METHOD("set_max_threads", "count"), &AssetConverter::set_max_threads);
+    ClassDB::bind_static_method("AssetConverter", D_METHOD("get_max_threads"), &AssetConverter::get_max_threads);
+
+    ClassDB::bind_method(D_METHOD("set_cache_directory", "path"), &AssetConverter::set_cache_directory);
+    ClassDB::bind_method(D_METHOD("get_cache_directory"), &AssetConverter::get_cache_directory);
+    ClassDB::bind_method(D_METHOD("set_cache_max_size", "bytes"), &AssetConverter::set_cache_max_size);
+    ClassDB::bind_method(D_METHOD("get_cache_max_size"), &AssetConverter::get_cache_max_size);
+    ClassDB::bind_method(D_METHOD("get_cache_hit_count"), &AssetConverter::get_cache_hit_count);
+    ClassDB::bind_method(D_METHOD("get_cache_miss_count"), &AssetConverter::get_cache_miss_count);
+    ClassDB::bind_method(D_METHOD("get_shared_texture_reuse_count"), &AssetConverter::get_shared_texture_reuse_count);
+
+    ClassDB::bind_method(D_METHOD("set_incremental", "enabled"), &AssetConverter::set_incremental);
+    ClassDB::bind_method(D_METHOD("is_incremental"), &AssetConverter::is_incremental);
+
+    ClassDB::bind_method(D_METHOD("set_scheduling_policy", "policy"), &AssetConverter::set_scheduling_policy);
+    ClassDB::bind_method(D_METHOD("get_scheduling_policy"), &AssetConverter::get_scheduling_policy);
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "worker_count"), "set_worker_count", "get_worker_count");
+    ADD_PROPERTY(PropertyInfo(Variant::STRING, "cache_directory", PROPERTY_HINT_GLOBAL_DIR), "set_cache_directory", "get_cache_directory");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "cache_max_size"), "set_cache_max_size", "get_cache_max_size");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "incremental"), "set_incremental", "is_incremental");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "scheduling_policy", PROPERTY_HINT_ENUM, "FIFO,Longest First,Shortest First"), "set_scheduling_policy", "get_scheduling_policy");
 
     // Internal methods for deferred calls
     ClassDB::bind_method(D_METHOD("_emit_started", "task_id", "source_path"), &AssetConverter::_emit_started);
-    ClassDB::bind_method(D_METHOD("_emit_progress", "task_id", "source_path", "progress"), &AssetConverter::_emit_progress);
-    ClassDB::bind_method(D_METHOD("_emit_completed", "task_id", "source_path", "output_path", "error", "error_message"), &AssetConverter::_emit_completed);
-    ClassDB::bind_method(D_METHOD("_emit_batch_completed", "results"), &AssetConverter::_emit_batch_completed);
+    ClassDB::bind_method(D_METHOD("_emit_completed", "task_id", "source_path", "output_path", "error", "error_message", "progress"), &AssetConverter::_emit_completed);
+    ClassDB::bind_method(D_METHOD("_emit_batch_progress", "batch_id", "done", "total", "bytes_in", "bytes_out", "eta"), &AssetConverter::_emit_batch_progress);
+    ClassDB::bind_method(D_METHOD("_pump_progress"), &AssetConverter::_pump_progress);
+    ClassDB::bind_method(D_METHOD("_emit_batch_completed", "batch_id", "results"), &AssetConverter::_emit_batch_completed);
 }
 
 AssetConverter::AssetConverter() {
     next_task_id = 0;
     should_exit = false;
-    is_batch_mode = false;
+    next_batch_id = 0;
+    unfinished_count = 0;
+    scheduling_policy = SCHEDULE_LONGEST_FIRST;
+    incremental = false;
+    frame_pump_connected = false;
+    shared_texture_reuse_count = 0;
 
     queue_mutex.instantiate();
+    active_mutex.instantiate();
     work_semaphore.instantiate();
+    readahead_slots.instantiate();
+    readahead_slots->post(PIPELINE_READAHEAD_WORKERS);
 
     // Initialize basis universal encoder
     basisu::basisu_encoder_init();
 
-    // Create job pool with 4 threads (including calling thread)
-    basis_job_pool = new basisu::job_pool(4);
+    // Slots for every possible worker index, so the pool can grow while workers run
+    worker_threads.resize(TaskQueue::MAX_WORKERS);
+    worker_retired.resize(TaskQueue::MAX_WORKERS, 0);
+    progress_table.resize(TaskQueue::MAX_WORKERS);
 
-    // Start worker thread
-    worker_thread.instantiate();
-    worker_thread->start(callable_mp(this, &AssetConverter::_worker_function));
+    worker_count = MIN(default_worker_count(), TaskQueue::MAX_WORKERS);
+    task_queue.set_worker_count(worker_count);
+    for (int i = 0; i < worker_count; i++) {
+        _start_worker(i);
+    }
 }
 
 AssetConverter::~AssetConverter() {
-    // Signal worker thread to exit
+    _stop_workers();
+    batch_manifest.flush();
+}
+
+void AssetConverter::_start_worker(int worker_index) {
+    // A retired worker has returned (or is returning) from its loop, so this does not block
+    Ref<Thread> &thread = worker_threads[worker_index];
+    if (thread.is_valid() && thread->is_started()) {
+        thread->wait_to_finish();
+    }
+    worker_retired[worker_index] = 0;
+
+    thread.instantiate();
+    thread->start(callable_mp(this, &AssetConverter::_worker_function).bind(worker_index));
+}
+
+void AssetConverter::_stop_workers() {
+    // Signal all worker threads to exit
     should_exit = true;
-    work_semaphore->post();
+    for (const Ref<Thread> &thread : worker_threads) {
+        if (thread.is_valid()) {
+            work_semaphore->post();
+            readahead_slots->post();
+        }
+    }
+
+    // Wait for worker threads to finish their current task
+    for (Ref<Thread> &thread : worker_threads) {
+        if (thread.is_valid() && thread->is_started()) {
+            thread->wait_to_finish();
+        }
+        thread.unref();
+    }
+}
 
-    // Wait for worker thread to finish
-    if (worker_thread.is_valid() && worker_thread->is_started()) {
-        worker_thread->wait_to_finish();
+bool AssetConverter::_retire_worker(int worker_index) {
+    queue_mutex->lock();
+    bool retire = worker_index >= worker_count;
+    if (retire) {
+        worker_retired[worker_index] = 1;
     }
+    queue_mutex->unlock();
+    return retire;
+}
+
+static uint64_t file_size_or_zero(const String &path) {
+    Ref<FileAccess> file = FileAccess::open(path, FileAccess::READ);
+    return file.is_valid() ? file->get_length() : 0;
+}
 
-    // Clean up job pool
-    if (basis_job_pool) {
-        delete basis_job_pool;
-        basis_job_pool = nullptr;
+// Bytes read by a task: its source, or every layer of an assembled texture
+static uint64_t task_source_bytes(const Ref<ConversionTask> &task) {
+    if (task->get_type() != ConversionTask::IMAGES_TO_KTX2) {
+        return file_size_or_zero(task->get_source_path());
     }
+    PackedStringArray sources = task->get_options().get("sources", PackedStringArray());
+    uint64_t total = 0;
+    for (int i = 0; i < sources.size(); i++) {
+        total += file_size_or_zero(sources[i]);
+    }
+    return total;
 }
 
-void AssetConverter::_worker_function() {
+void AssetConverter::_worker_function(int worker_index) {
     while (!should_exit) {
+        // The pool shrank below this worker: leave once the current task is done
+        if (_retire_worker(worker_index)) {
+            return;
+        }
+
         // Wait for work
         work_semaphore->wait();
 
@@ -118,40 +263,406 @@ void AssetConverter::_worker_function() {
             break;
         }
 
-        // Get next task from queue
-        Ref<ConversionTask> task;
+        // The wake-up may have been meant for a queued task, so pass it on when retiring
+        if (_retire_worker(worker_index)) {
+            work_semaphore->post();
+            return;
+        }
+
+        // Hold a read-ahead slot before choosing a task (see EncoderLease). A worker
+        // waiting for a slot has not popped anything yet, so when it gets one the queue
+        // still hands it the highest-priority task rather than one it took earlier.
+        readahead_slots->wait();
+        if (should_exit) {
+            break;
+        }
+
+        // Get next task from this worker's deque, or steal one, and claim it. cancel()
+        // takes queued tasks through the same PENDING status, so exactly one side wins;
+        // a task it took first is skipped here.
+        Ref<ConversionTask> task = task_queue.pop(worker_index, (int64_t)Time::get_singleton()->get_ticks_usec());
+        bool processed = task.is_valid() && task->try_set_status(ConversionTask::PENDING, ConversionTask::RUNNING);
+        int64_t bytes_in = 0;
+        int64_t bytes_out = 0;
+
+        // A cancel request that arrived while the task was being claimed ends it here,
+        // like a task cancelled while queued
+        if (processed && task->is_cancel_requested()) {
+            processed = false;
+            task->set_status(ConversionTask::CANCELLED);
+            task->set_error(ERR_SKIP);
+            task->set_error_message("Task cancelled");
+        }
+
+        if (processed) {
+            // The task draws threads from the process-wide budget only for its encode
+            // stage (see EncoderLease). Tasks found up to date in incremental mode, or
+            // completed from the cache, never draw any.
+            bool up_to_date = _is_up_to_date(task);
+            if (up_to_date) {
+                readahead_slots->post();
+            }
+            bool parallel = task->get_type() == ConversionTask::IMAGE_TO_KTX2 ||
+                            task->get_type() == ConversionTask::IMAGES_TO_KTX2 ||
+                            task->get_type() == ConversionTask::GLB_TEXTURES_TO_KTX2 ||
+                            (task->get_type() == ConversionTask::AUDIO_TO_MP3 && (bool)task->get_options().get("parallel_segments", false));
+            EncoderLease lease(parallel, task->get_priority(), up_to_date ? nullptr : readahead_slots.ptr());
+            progress_table.begin(worker_index, task->get_id());
+            _process_task(task, lease, up_to_date);
+            progress_table.end(worker_index);
+
+            // Only batches report bytes, so tasks queued on their own skip the file sizes
+            if (task->get_batch_id() >= 0 && task->get_status() == ConversionTask::COMPLETED) {
+                bytes_in = (int64_t)task_source_bytes(task);
+                bytes_out = (int64_t)file_size_or_zero(task->get_output_path());
+            }
+        } else {
+            readahead_slots->post();
+        }
+
+        if (task.is_valid()) {
+            active_mutex->lock();
+            active_tasks.erase(task->get_id());
+            active_mutex->unlock();
+        }
+
+        // Check if batch is complete (queue drained and no other worker still busy)
         {
             queue_mutex->lock();
-            if (!task_queue.is_empty()) {
-                task = task_queue[0];
-                task_queue.remove_at(0);
+            if (task.is_valid()) {
+                unfinished_count--;
+                _finish_batch_task(task, processed, bytes_in, bytes_out);
             }
+            bool idle = unfinished_count == 0;
             queue_mutex->unlock();
+
+            if (idle) {
+                batch_manifest.flush();
+            }
         }
+    }
+}
+
+// Helper to read at most max_size bytes from the start of a file
+static bool read_file_head(const char *path, std::vector<uint8_t> &data, size_t max_size) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::streamsize size = std::min<std::streamsize>(file.tellg(), (std::streamsize)max_size);
+    file.seekg(0, std::ios::beg);
+
+    data.resize(size);
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(data.data()), size));
+}
 
-        if (task.is_valid() && task->get_status() == ConversionTask::PENDING) {
-            _process_task(task);
+// Map quality (1-255) to UASTC pack level
+static uint32_t quality_to_uastc_level(int quality) {
+    if (quality <= 50) {
+        return basisu::cPackUASTCLevelFastest;
+    } else if (quality <= 100) {
+        return basisu::cPackUASTCLevelFaster;
+    } else if (quality <= 150) {
+        return basisu::cPackUASTCLevelDefault;
+    } else if (quality <= 200) {
+        return basisu::cPackUASTCLevelSlower;
+    }
+    return basisu::cPackUASTCLevelVerySlow;
+}
+
+static bool is_hdr_encoder(int encoder) {
+    return encoder == ConversionTask::ENCODER_UASTC_HDR_4X4 || encoder == ConversionTask::ENCODER_ASTC_HDR_6X6;
+}
+
+// Encoder actually used for a source: HDR sources always get an HDR encoder,
+// UASTC HDR 4x4 unless ASTC HDR 6x6 was asked for
+static int resolve_encoder(const Dictionary &options, bool hdr_source) {
+    int encoder = options.get("encoder", (int)ConversionTask::ENCODER_UASTC);
+    if (hdr_source && !is_hdr_encoder(encoder)) {
+        return ConversionTask::ENCODER_UASTC_HDR_4X4;
+    }
+    return encoder;
+}
+
+// Rough single-core KTX2 encode time in seconds per megapixel for a task's options
+static float encode_seconds_per_megapixel(const Dictionary &options, bool hdr_source = false) {
+    int quality = options.get("quality", 128);
+    bool mipmaps = options.get("mipmaps", true);
+    int encoder = resolve_encoder(options, hdr_source);
+
+    float seconds;
+    if (encoder == ConversionTask::ENCODER_ETC1S) {
+        // Dominated by endpoint/selector clustering, which grows with the compression level
+        int compression_level = CLAMP((int)options.get("compression_level", 2), 0, 6);
+        seconds = 0.2f * (float)(compression_level + 1);
+    } else if (encoder == ConversionTask::ENCODER_UASTC_HDR_4X4) {
+        seconds = 1.0f;
+    } else if (encoder == ConversionTask::ENCODER_ASTC_HDR_6X6) {
+        seconds = 3.0f;
+    } else {
+        switch (quality_to_uastc_level(quality)) {
+            case basisu::cPackUASTCLevelFastest: seconds = 0.05f; break;
+            case basisu::cPackUASTCLevelFaster: seconds = 0.1f; break;
+            case basisu::cPackUASTCLevelDefault: seconds = 0.3f; break;
+            case basisu::cPackUASTCLevelSlower: seconds = 1.0f; break;
+            default: seconds = 3.0f; break;
         }
+    }
+    // A full mip chain adds a third of the base level's pixels
+    return mipmaps ? seconds * 1.33f : seconds;
+}
 
-        // Check if batch is complete
-        {
-            queue_mutex->lock();
-            if (is_batch_mode && task_queue.is_empty()) {
-                is_batch_mode = false;
-                Array results = batch_results.duplicate();
-                batch_results.clear();
-                queue_mutex->unlock();
+// Encoder settings shared by every KTX2 output, from a task's options:
+// UASTC LDR 4x4 with Zstandard supercompression, ETC1S with BasisLZ, or for HDR
+// sources UASTC HDR 4x4 / ASTC HDR 6x6 with Zstandard
+static void apply_encoder_options(basisu::basis_compressor_params &params, const Dictionary &options, bool hdr_source = false) {
+    int quality = options.get("quality", 128);
+    bool mipmaps = options.get("mipmaps", true);
+    int encoder = resolve_encoder(options, hdr_source);
 
-                call_deferred("_emit_batch_completed", results);
-            } else {
-                queue_mutex->unlock();
+    params.m_create_ktx2_file = true;
+    if (is_hdr_encoder(encoder)) {
+        // Source images go in m_source_images_hdr; data is linear, so no sRGB handling
+        params.m_hdr = true;
+        params.m_perceptual = false;
+        params.m_mip_srgb = false;
+        params.m_ktx2_srgb_transfer_func = false;
+        if (encoder == ConversionTask::ENCODER_ASTC_HDR_6X6) {
+            // Effort levels 0-12
+            params.m_hdr_mode = basisu::hdr_modes::cASTC_HDR_6X6;
+            params.m_astc_hdr_6x6_options.set_user_level(CLAMP(quality, 0, 255) * 12 / 255);
+        } else {
+            // Effort levels 0-4
+            params.m_hdr_mode = basisu::hdr_modes::cUASTC_HDR_4X4;
+            params.m_uastc_hdr_4x4_options.set_quality_level(CLAMP(quality, 0, 255) * 4 / 255);
+        }
+        params.m_ktx2_uastc_supercompression = basist::KTX2_SS_ZSTANDARD;
+        params.m_ktx2_zstd_supercompression_level = 6;
+    } else if (encoder == ConversionTask::ENCODER_ETC1S) {
+        // ETC1S quality level (1-255) and effort (0-6); BasisLZ is implied for KTX2
+        params.m_uastc = false;
+        params.m_quality_level = CLAMP(quality, 1, 255);
+        params.m_compression_level = CLAMP((int)options.get("compression_level", 2), 0, 6);
+    } else {
+        params.m_uastc = true;
+        params.m_pack_uastc_ldr_4x4_flags = quality_to_uastc_level(quality);
+        params.m_ktx2_uastc_supercompression = basist::KTX2_SS_ZSTANDARD;
+        params.m_ktx2_zstd_supercompression_level = 6;  // Moderate compression
+    }
+
+    // Mipmap settings
+    params.m_mip_gen = mipmaps;
+    if (mipmaps) {
+        params.m_mip_filter = "kaiser";
+    }
+
+    // Disable status output for library use
+    params.m_status_output = false;
+}
+
+static bool is_exr_image(const uint8_t *data, size_t size) {
+    return size >= 4 && data[0] == 0x76 && data[1] == 0x2f && data[2] == 0x31 && data[3] == 0x01;
+}
+
+// True for sources with floating-point texels (Radiance .hdr, OpenEXR)
+static bool is_hdr_image(const uint8_t *data, size_t size) {
+    return is_exr_image(data, size) || stbi_is_hdr_from_memory(data, (int)size) != 0;
+}
+
+// Decode an 8-bit source to RGBA with stb_image (PNG, JPEG, BMP, TGA, GIF, PSD, PIC).
+// The image adopts stb's buffer instead of copying it: stb allocates with malloc
+// (STBI_MALLOC is not overridden) and basisu::image releases its pixels with free().
+static bool decode_image_ldr(const uint8_t *data, size_t size, basisu::image &r_image, String &r_error) {
+    int width, height, channels;
+    uint8_t *rgba = stbi_load_from_memory(data, (int)size, &width, &height, &channels, 4);  // Force RGBA output
+    if (!rgba) {
+        r_error = stbi_failure_reason();
+        return false;
+    }
+    r_image.grant_ownership(reinterpret_cast<basisu::color_rgba*>(rgba), (uint32_t)width, (uint32_t)height);
+    return true;
+}
+
+// Decode a source to linear float RGBA: OpenEXR through tinyexr, everything else
+// through stb (8-bit sources are converted from sRGB)
+static bool decode_image_hdr(const uint8_t *data, size_t size, basisu::imagef &r_image, String &r_error) {
+    float *rgba = nullptr;
+    int width = 0, height = 0;
+
+    if (is_exr_image(data, size)) {
+        const char *err = nullptr;
+        if (LoadEXRFromMemory(&rgba, &width, &height, data, size, &err) != TINYEXR_SUCCESS) {
+            r_error = err ? String(err) : String("invalid EXR file");
+            if (err) {
+                FreeEXRErrorMessage(err);
+            }
+            return false;
+        }
+        r_image.resize(width, height);
+        memcpy(r_image.get_ptr(), rgba, (size_t)width * height * 4 * sizeof(float));
+        free(rgba);
+        return true;
+    }
+
+    int channels;
+    rgba = stbi_loadf_from_memory(data, (int)size, &width, &height, &channels, 4);
+    if (!rgba) {
+        r_error = stbi_failure_reason();
+        return false;
+    }
+    r_image.resize(width, height);
+    memcpy(r_image.get_ptr(), rgba, (size_t)width * height * 4 * sizeof(float));
+    stbi_image_free(rgba);
+    return true;
+}
+
+// Downscale settings from a task's options
+static ImageResize::Settings resize_settings(const Dictionary &options) {
+    ImageResize::Settings settings;
+    settings.max_size = (uint32_t)MAX(0, (int)options.get("max_size", 0));
+    settings.scale = options.get("scale", 1.0f);
+    settings.pow2 = options.get("pow2", false);
+    return settings;
+}
+
+// Estimate a task's single-core run time in seconds from file headers only.
+// Returns 0 when the source cannot be inspected; such tasks fail fast anyway.
+static float estimate_task_cost(const Ref<ConversionTask> &task) {
+    CharString source_utf8 = task->get_source_path().utf8();
+    const char *source_path = source_utf8.get_data();
+    Dictionary options = task->get_options();
+
+    switch (task->get_type()) {
+        case ConversionTask::IMAGE_TO_KTX2:
+        case ConversionTask::IMAGES_TO_KTX2: {
+            PackedStringArray sources = options.get("sources", PackedStringArray());
+            if (task->get_type() == ConversionTask::IMAGE_TO_KTX2) {
+                sources = PackedStringArray();
+                sources.push_back(task->get_source_path());
+            }
+
+            // Image dimensions are in the first few KB for every format stb supports
+            float megapixels = 0.0f;
+            bool hdr_source = false;
+            std::vector<uint8_t> head;
+            for (int i = 0; i < sources.size(); i++) {
+                CharString path_utf8 = sources[i].utf8();
+                int width, height, channels;
+                if (!read_file_head(path_utf8.get_data(), head, 64 * 1024) ||
+                    !stbi_info_from_memory(head.data(), (int)head.size(), &width, &height, &channels)) {
+                    return 0.0f;
+                }
+                // Encode cost follows the size after downscaling
+                uint32_t target_width, target_height;
+                ImageResize::target_size(resize_settings(options), (uint32_t)width, (uint32_t)height, target_width, target_height);
+                megapixels += (float)target_width * (float)target_height / 1.0e6f;
+                hdr_source = hdr_source || stbi_is_hdr_from_memory(head.data(), (int)head.size()) != 0;
+            }
+            return megapixels * encode_seconds_per_megapixel(options, hdr_source);
+        }
+
+        case ConversionTask::AUDIO_TO_MP3:
+        case ConversionTask::NORMALIZE_AUDIO: {
+            drwav wav;
+            if (!drwav_init_file(&wav, source_path, nullptr)) {
+                return 0.0f;
+            }
+            double samples = (double)wav.totalPCMFrameCount * wav.channels;
+            drwav_uninit(&wav);
+
+            // LAME encodes roughly 5M samples/s per core; normalization is two passes over memory
+            double samples_per_second = task->get_type() == ConversionTask::AUDIO_TO_MP3 ? 5.0e6 : 50.0e6;
+            return (float)(samples / samples_per_second);
+        }
+
+        case ConversionTask::GLB_TEXTURES_TO_KTX2: {
+            // Only the JSON chunk is needed: the image sizes are the buffer view lengths
+            std::vector<uint8_t> head;
+            if (!read_file_head(source_path, head, 20) || head.size() < 20 ||
+                *(uint32_t*)head.data() != 0x46546C67) {
+                return 0.0f;
+            }
+            uint32_t json_chunk_length = *(uint32_t*)&head[12];
+            if (!read_file_head(source_path, head, 20 + (size_t)json_chunk_length) ||
+                head.size() < 20 + (size_t)json_chunk_length) {
+                return 0.0f;
+            }
+
+            cgltf_options cgltf_opts = {};
+            cgltf_data *data = nullptr;
+            if (cgltf_parse(&cgltf_opts, head.data() + 20, json_chunk_length, &data) != cgltf_result_success) {
+                return 0.0f;
+            }
+
+            // Approximate pixel counts from compressed sizes (PNG ~2 bytes/pixel, JPEG ~0.25),
+            // then apply the downscale settings
+            ImageResize::Settings resize = resize_settings(options);
+            float resize_scale = resize.scale > 0.0f ? resize.scale * resize.scale : 1.0f;
+            float max_megapixels = resize.max_size > 0 ? (float)resize.max_size * (float)resize.max_size / 1.0e6f : 0.0f;
+            float megapixels = 0.0f;
+            for (size_t i = 0; i < data->images_count; i++) {
+                const cgltf_image *image = &data->images[i];
+                if (!image->buffer_view) {
+                    continue;
+                }
+                bool is_jpeg = image->mime_type && strcmp(image->mime_type, "image/jpeg") == 0;
+                float bytes = (float)image->buffer_view->size;
+                float image_megapixels = (is_jpeg ? bytes * 4.0f : bytes * 0.5f) / 1.0e6f * resize_scale;
+                megapixels += max_megapixels > 0.0f ? MIN(image_megapixels, max_megapixels) : image_megapixels;
             }
+            cgltf_free(data);
+
+            return megapixels * encode_seconds_per_megapixel(options);
         }
     }
+
+    return 0.0f;
+}
+
+// Options serialized with keys in sorted order, so manifest entries and cache keys do not
+// depend on the order a Dictionary was filled in
+static std::string canonical_options(const Dictionary &options) {
+    std::vector<std::pair<std::string, std::string>> fields;
+    Array keys = options.keys();
+    fields.reserve(keys.size());
+    for (int i = 0; i < keys.size(); i++) {
+        fields.emplace_back(String(keys[i]).utf8().get_data(), Variant(options[keys[i]]).stringify().utf8().get_data());
+    }
+    std::sort(fields.begin(), fields.end());
+
+    std::string result;
+    for (const auto &field : fields) {
+        result += field.first + "=" + field.second + ";";
+    }
+    return result;
+}
+
+// Result entry reported for a task in batch_completed
+static Dictionary batch_result(const Ref<ConversionTask> &task) {
+    Dictionary result;
+    result["task_id"] = task->get_id();
+    result["source_path"] = task->get_source_path();
+    result["output_path"] = task->get_output_path();
+    result["error"] = (int)task->get_error();
+    result["error_message"] = task->get_error_message();
+    return result;
+}
+
+// Output path of a task, with the default for GLB tasks that do not set one
+static String resolve_output_path(const Ref<ConversionTask> &task) {
+    if (task->get_output_path().is_empty() && task->get_type() == ConversionTask::GLB_TEXTURES_TO_KTX2) {
+        return task->get_source_path().get_basename() + "_ktx2.glb";
+    }
+    return task->get_output_path();
 }
 
-void AssetConverter::_process_task(Ref<ConversionTask> task) {
-    task->set_status(ConversionTask::RUNNING);
+void AssetConverter::_process_task(Ref<ConversionTask> task, EncoderLease &lease, bool up_to_date) {
+    // Batch tasks were estimated when convert_batch() ordered them; tasks queued on
+    // their own are estimated here, off the caller's thread
+    if (task->get_estimated_cost() < 0.0f) {
+        task->set_estimated_cost(estimate_task_cost(task));
+    }
 
     // Emit started signal on main thread
     call_deferred("_emit_started", task->get_id(), task->get_source_path());
@@ -167,37 +678,53 @@ void AssetConverter::_process_task(Ref<ConversionTask> task) {
             task->get_source_path(),
             task->get_output_path(),
             (int)task->get_error(),
-            task->get_error_message());
-
-        // Add to batch results if in batch mode
-        if (is_batch_mode) {
-            queue_mutex->lock();
-            Dictionary result;
-            result["task_id"] = task->get_id();
-            result["source_path"] = task->get_source_path();
-            result["output_path"] = task->get_output_path();
-            result["error"] = (int)task->get_error();
-            result["error_message"] = task->get_error_message();
-            batch_results.push_back(result);
-            queue_mutex->unlock();
-        }
+            task->get_error_message(),
+            task->get_progress());
         return;
     }
 
-    // Process based on type
-    switch (task->get_type()) {
-        case ConversionTask::IMAGE_TO_KTX2:
-            _convert_image_to_ktx2(task);
-            break;
-        case ConversionTask::AUDIO_TO_MP3:
-            _convert_audio_to_mp3(task);
-            break;
-        case ConversionTask::GLB_TEXTURES_TO_KTX2:
-            _convert_glb_textures_to_ktx2(task);
-            break;
-        case ConversionTask::NORMALIZE_AUDIO:
-            _normalize_audio(task);
-            break;
+    // GLB outputs default to a path next to the source
+    if (task->get_output_path().is_empty()) {
+        task->set_output_path(resolve_output_path(task));
+    }
+
+    if (up_to_date) {
+        task->set_status(ConversionTask::COMPLETED);
+        task->set_error(OK);
+        task->set_error_message("Output is up to date");
+        task->set_progress(1.0f);
+        _report_progress(task);
+    } else {
+        // Process based on type
+        switch (task->get_type()) {
+            case ConversionTask::IMAGE_TO_KTX2:
+            case ConversionTask::IMAGES_TO_KTX2:
+                _convert_image_to_ktx2(task, lease);
+                break;
+            case ConversionTask::AUDIO_TO_MP3:
+                _convert_audio_to_mp3(task, lease);
+                break;
+            case ConversionTask::GLB_TEXTURES_TO_KTX2:
+                _convert_glb_textures_to_ktx2(task, lease);
+                break;
+            case ConversionTask::NORMALIZE_AUDIO:
+                _normalize_audio(task, lease);
+                break;
+        }
+
+        // A converter that saw a cancel request returns with the task still running.
+        // A task that finished before it noticed keeps its result.
+        if (task->get_status() == ConversionTask::RUNNING && task->is_cancel_requested()) {
+            task->set_status(ConversionTask::CANCELLED);
+            task->set_error(ERR_SKIP);
+            task->set_error_message("Task cancelled");
+        }
+
+        if (incremental && task->get_status() == ConversionTask::COMPLETED && task->get_type() != ConversionTask::IMAGES_TO_KTX2) {
+            CharString source_utf8 = task->get_source_path().utf8();
+            CharString output_utf8 = task->get_output_path().utf8();
+            batch_manifest.record((int)task->get_type(), source_utf8.get_data(), output_utf8.get_data(), canonical_options(task->get_options()));
+        }
     }
 
     // Emit completed signal on main thread
@@ -206,166 +733,370 @@ void AssetConverter::_process_task(Ref<ConversionTask> task) {
         task->get_source_path(),
         task->get_output_path(),
         (int)task->get_error(),
-        task->get_error_message());
-
-    // Add to batch results if in batch mode
-    if (is_batch_mode) {
-        queue_mutex->lock();
-        Dictionary result;
-        result["task_id"] = task->get_id();
-        result["source_path"] = task->get_source_path();
-        result["output_path"] = task->get_output_path();
-        result["error"] = (int)task->get_error();
-        result["error_message"] = task->get_error_message();
-        batch_results.push_back(result);
-        queue_mutex->unlock();
-    }
+        task->get_error_message(),
+        task->get_progress());
 }
 
 void AssetConverter::_emit_started(int task_id, const String &source_path) {
+    emitted_tasks[task_id] = EmittedTask{ source_path, 0.0f };
     emit_signal("conversion_started", task_id, source_path);
 }
 
-void AssetConverter::_emit_progress(int task_id, const String &source_path, float progress) {
-    emit_signal("conversion_progress", task_id, source_path, progress);
+void AssetConverter::_report_progress(const Ref<ConversionTask> &task) {
+    progress_table.set(task->get_id(), task->get_progress());
+    if (progress_table.request_pump((int64_t)Time::get_singleton()->get_ticks_usec())) {
+        call_deferred("_pump_progress");
+    }
 }
 
-void AssetConverter::_emit_completed(int task_id, const String &source_path, const String &output_path, Error error, const String &error_message) {
+void AssetConverter::_pump_progress() {
+    progress_table.drain((int64_t)Time::get_singleton()->get_ticks_usec(), [this](int task_id, float progress) {
+        // Held back until the started signal has been delivered
+        auto it = emitted_tasks.find(task_id);
+        if (it == emitted_tasks.end()) {
+            return false;
+        }
+        if (progress > it->second.progress) {
+            it->second.progress = progress;
+            emit_signal("conversion_progress", task_id, it->second.source_path, progress);
+        }
+        return true;
+    });
+
+    // Totals of every unfinished batch; the final report comes with its completion
+    struct BatchTotals {
+        int batch_id;
+        int done;
+        int total;
+        int64_t bytes_in;
+        int64_t bytes_out;
+        float eta;
+    };
+    std::vector<BatchTotals> batch_totals;
+    int64_t now_usec = (int64_t)Time::get_singleton()->get_ticks_usec();
+    queue_mutex->lock();
+    batch_totals.reserve(batches.size());
+    for (const auto &entry : batches) {
+        const Batch &batch = entry.second;
+        batch_totals.push_back(BatchTotals{ entry.first, batch.done, batch.total, batch.bytes_in, batch.bytes_out,
+                _estimate_batch_eta(batch, now_usec) });
+    }
+    queue_mutex->unlock();
+    for (const BatchTotals &totals : batch_totals) {
+        _emit_batch_progress(totals.batch_id, totals.done, totals.total, totals.bytes_in, totals.bytes_out, totals.eta);
+    }
+
+    // Updates held back by the rate limit are picked up from the frame loop, so the
+    // last one is delivered even if the task reports nothing more for a while
+    if (!frame_pump_connected) {
+        SceneTree *tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+        if (tree) {
+            tree->connect("process_frame", callable_mp(this, &AssetConverter::_on_process_frame));
+            frame_pump_connected = true;
+        }
+    }
+}
+
+void AssetConverter::_on_process_frame() {
+    if (progress_table.is_pump_overdue((int64_t)Time::get_singleton()->get_ticks_usec())) {
+        _pump_progress();
+    }
+}
+
+float AssetConverter::_estimate_batch_eta(const Batch &batch, int64_t now_usec) {
+    if (batch.done <= 0) {
+        return -1.0f;
+    }
+    double elapsed = (double)(now_usec - batch.start_usec) / 1.0e6;
+    return (float)(elapsed / batch.done * (batch.total - batch.done));
+}
+
+void AssetConverter::_emit_completed(int task_id, const String &source_path, const String &output_path, Error error, const String &error_message, float progress) {
+    // The final progress may still be held back by the rate limit
+    auto it = emitted_tasks.find(task_id);
+    if (it != emitted_tasks.end()) {
+        if (progress > it->second.progress) {
+            emit_signal("conversion_progress", task_id, source_path, progress);
+        }
+        emitted_tasks.erase(it);
+    }
     emit_signal("conversion_completed", task_id, source_path, output_path, (int)error, error_message);
 }
 
-void AssetConverter::_emit_batch_completed(const Array &results) {
-    emit_signal("batch_completed", results);
+void AssetConverter::_emit_batch_progress(int batch_id, int done, int total, int64_t bytes_in, int64_t bytes_out, float eta) {
+    emit_signal("batch_progress", batch_id, done, total, bytes_in, bytes_out, eta);
 }
 
-// Helper to read file into vector
-static bool read_file_to_vector(const char *path, std::vector<uint8_t> &data) {
-    std::ifstream file(path, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
-        return false;
+void AssetConverter::_finish_batch_task(const Ref<ConversionTask> &task, bool processed, int64_t bytes_in, int64_t bytes_out) {
+    auto it = batches.find(task->get_batch_id());
+    if (it == batches.end()) {
+        return;
     }
+    Batch &batch = it->second;
+    batch.done++;
+    batch.bytes_in += bytes_in;
+    batch.bytes_out += bytes_out;
 
-    std::streamsize size = file.tellg();
-    file.seekg(0, std::ios::beg);
+    // Tasks cancelled before they started report no result
+    if (processed) {
+        batch.results.push_back(batch_result(task));
+    }
 
-    data.resize(size);
-    return static_cast<bool>(file.read(reinterpret_cast<char*>(data.data()), size));
+    if (--batch.remaining == 0) {
+        call_deferred("_emit_batch_progress", it->first, batch.done, batch.total, batch.bytes_in, batch.bytes_out, 0.0f);
+        call_deferred("_emit_batch_completed", it->first, batch.results);
+        batches.erase(it);
+    }
 }
 
-// Helper to write vector to file
-static bool write_vector_to_file(const char *path, const std::vector<uint8_t> &data) {
-    std::ofstream file(path, std::ios::binary);
-    if (!file.is_open()) {
+std::shared_ptr<SharedTextureCache> AssetConverter::_get_shared_textures(const Ref<ConversionTask> &task) {
+    queue_mutex->lock();
+    auto it = batches.find(task->get_batch_id());
+    std::shared_ptr<SharedTextureCache> shared_textures = it != batches.end() ? it->second.shared_textures : nullptr;
+    queue_mutex->unlock();
+    return shared_textures;
+}
+
+void AssetConverter::_emit_batch_completed(int batch_id, const Array &results) {
+    emit_signal("batch_completed", batch_id, results);
+}
+
+bool AssetConverter::_is_up_to_date(const Ref<ConversionTask> &task) {
+    // The manifest tracks a single source, so assembled textures are always rebuilt
+    String output_path = resolve_output_path(task);
+    if (!incremental || output_path.is_empty() || task->get_type() == ConversionTask::IMAGES_TO_KTX2) {
         return false;
     }
+    CharString source_utf8 = task->get_source_path().utf8();
+    CharString output_utf8 = output_path.utf8();
+    return batch_manifest.is_up_to_date((int)task->get_type(), source_utf8.get_data(), output_utf8.get_data(), canonical_options(task->get_options()));
+}
 
-    file.write(reinterpret_cast<const char*>(data.data()), data.size());
-    return file.good();
+std::string AssetConverter::_get_cache_key(const Ref<ConversionTask> &task, const uint8_t *source, size_t source_size) {
+    if (!conversion_cache.is_enabled()) {
+        return std::string();
+    }
+    return ConversionCache::make_key((int)task->get_type(), source, source_size, canonical_options(task->get_options()));
 }
 
-void AssetConverter::_convert_image_to_ktx2(Ref<ConversionTask> task) {
-    CharString source_utf8 = task->get_source_path().utf8();
+bool AssetConverter::_complete_from_cache(const Ref<ConversionTask> &task, const std::string &cache_key, const char *output_path) {
+    if (cache_key.empty() || !conversion_cache.fetch(cache_key, output_path)) {
+        return false;
+    }
+
+    task->set_status(ConversionTask::COMPLETED);
+    task->set_error(OK);
+    task->set_error_message("Loaded from conversion cache");
+    task->set_progress(1.0f);
+    _report_progress(task);
+    return true;
+}
+
+void AssetConverter::_convert_image_to_ktx2(Ref<ConversionTask> task, EncoderLease &lease) {
     CharString output_utf8 = task->get_output_path().utf8();
-    const char *source_path = source_utf8.get_data();
     const char *output_path = output_utf8.get_data();
 
     Dictionary options = task->get_options();
-    int quality = options.get("quality", 128);
-    bool mipmaps = options.get("mipmaps", true);
 
-    // Report progress
-    task->set_progress(0.1f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    // One source for a plain image; one per layer, face or slice when assembling
+    PackedStringArray source_paths = options.get("sources", PackedStringArray());
+    if (task->get_type() == ConversionTask::IMAGE_TO_KTX2) {
+        source_paths = PackedStringArray();
+        source_paths.push_back(task->get_source_path());
+    }
+    size_t source_count = (size_t)source_paths.size();
+    if (source_count == 0) {
+        task->set_status(ConversionTask::FAILED);
+        task->set_error(ERR_INVALID_PARAMETER);
+        task->set_error_message("No source images");
+        return;
+    }
 
-    // Read source image
-    std::vector<uint8_t> file_data;
-    if (!read_file_to_vector(source_path, file_data)) {
+    // Basis Universal has no 3D texture output: its KTX2 writer stores slices as array
+    // layers, and its transcoder rejects files with a depth
+    if (task->get_type() == ConversionTask::IMAGES_TO_KTX2 &&
+        (int)options.get("layout", (int)ConversionTask::LAYOUT_2D_ARRAY) == ConversionTask::LAYOUT_VOLUME) {
         task->set_status(ConversionTask::FAILED);
-        task->set_error(ERR_FILE_CANT_OPEN);
-        task->set_error_message("Failed to read source file");
+        task->set_error(ERR_UNAVAILABLE);
+        task->set_error_message("Volume textures are not supported by the Basis Universal encoder");
         return;
     }
 
+    // Report progress
+    task->set_progress(0.1f);
+    _report_progress(task);
+
+    // Map source images
+    std::vector<MappedFile> source_files(source_count);
+    for (size_t i = 0; i < source_count; i++) {
+        CharString source_utf8 = source_paths[i].utf8();
+        if (!source_files[i].open(source_utf8.get_data())) {
+            task->set_status(ConversionTask::FAILED);
+            task->set_error(ERR_FILE_CANT_OPEN);
+            task->set_error_message("Failed to read source file: " + source_paths[i]);
+            return;
+        }
+    }
+
     // Check for cancellation
-    if (task->get_status() == ConversionTask::CANCELLED) {
+    if (task->is_cancel_requested()) {
+        return;
+    }
+
+    // Reuse a previous output for identical source bytes and options. Several sources
+    // are keyed by the keys of each one, in order.
+    std::string cache_key = _get_cache_key(task, source_files[0].data(), source_files[0].size());
+    if (source_count > 1 && !cache_key.empty()) {
+        for (size_t i = 1; i < source_count; i++) {
+            cache_key += _get_cache_key(task, source_files[i].data(), source_files[i].size());
+        }
+        cache_key = _get_cache_key(task, reinterpret_cast<const uint8_t*>(cache_key.data()), cache_key.size());
+    }
+    if (_complete_from_cache(task, cache_key, output_path)) {
         return;
     }
 
     task->set_progress(0.2f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
 
-    // Load image using stb_image (supports PNG, JPEG, BMP, TGA, GIF, PSD, HDR, PIC)
-    int width, height, channels;
-    uint8_t *image_data = stbi_load_from_memory(
-        file_data.data(), (int)file_data.size(),
-        &width, &height, &channels, 4);  // Force RGBA output
+    // Radiance .hdr and OpenEXR sources (or an explicit HDR encoder) take the float path,
+    // everything else is decoded to 8-bit RGBA. One HDR layer makes the whole texture HDR.
+    bool hdr = false;
+    for (const MappedFile &source_file : source_files) {
+        hdr = hdr || is_hdr_image(source_file.data(), source_file.size());
+    }
+    hdr = is_hdr_encoder(resolve_encoder(options, hdr));
 
-    if (!image_data) {
-        task->set_status(ConversionTask::FAILED);
-        task->set_error(ERR_INVALID_DATA);
-        task->set_error_message(String("Failed to decode image: ") + stbi_failure_reason());
-        return;
+    basisu::basis_compressor_params params;
+    if (hdr) {
+        params.m_source_images_hdr.resize(source_count);
+    } else {
+        params.m_source_images.resize(source_count);
     }
 
-    basisu::image img;
-    img.resize(width, height);
-    memcpy(img.get_ptr(), image_data, width * height * 4);
-    stbi_image_free(image_data);
+    // A single image is decoded before drawing encoder threads, so its read and decode
+    // overlap other tasks' encodes; the layers of an assembled texture are decoded in
+    // parallel on the task's threads
+    basisu::job_pool *job_pool = source_count > 1 ? lease.acquire() : nullptr;
+    std::vector<String> decode_errors(source_count);
+    auto decode_source = [&](size_t i) {
+        if (task->is_cancel_requested()) {
+            return;
+        }
+        const MappedFile &source_file = source_files[i];
+        if (hdr) {
+            decode_image_hdr(source_file.data(), source_file.size(), params.m_source_images_hdr[i], decode_errors[i]);
+        } else {
+            decode_image_ldr(source_file.data(), source_file.size(), params.m_source_images[i], decode_errors[i]);
+        }
+    };
+    for (size_t i = 0; i < source_count; i++) {
+        if (job_pool) {
+            job_pool->add_job([&, i]() { decode_source(i); });
+        } else {
+            decode_source(i);
+        }
+    }
+    if (job_pool) {
+        job_pool->wait_for_all();
+    }
 
     // Check for cancellation
-    if (task->get_status() == ConversionTask::CANCELLED) {
+    if (task->is_cancel_requested()) {
         return;
     }
 
-    task->set_progress(0.4f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    for (size_t i = 0; i < source_count; i++) {
+        if (!decode_errors[i].is_empty()) {
+            task->set_status(ConversionTask::FAILED);
+            task->set_error(ERR_INVALID_DATA);
+            task->set_error_message("Failed to decode image " + source_paths[i] + ": " + decode_errors[i]);
+            return;
+        }
+    }
 
-    // Map quality (1-255) to UASTC pack level
-    uint32_t uastc_level;
-    if (quality <= 50) {
-        uastc_level = basisu::cPackUASTCLevelFastest;
-    } else if (quality <= 100) {
-        uastc_level = basisu::cPackUASTCLevelFaster;
-    } else if (quality <= 150) {
-        uastc_level = basisu::cPackUASTCLevelDefault;
-    } else if (quality <= 200) {
-        uastc_level = basisu::cPackUASTCLevelSlower;
-    } else {
-        uastc_level = basisu::cPackUASTCLevelVerySlow;
+    // Layers must share one size; cube faces must also be square and come in sixes
+    if (task->get_type() == ConversionTask::IMAGES_TO_KTX2) {
+        uint32_t width = hdr ? params.m_source_images_hdr[0].get_width() : params.m_source_images[0].get_width();
+        uint32_t height = hdr ? params.m_source_images_hdr[0].get_height() : params.m_source_images[0].get_height();
+        for (size_t i = 1; i < source_count; i++) {
+            uint32_t layer_width = hdr ? params.m_source_images_hdr[i].get_width() : params.m_source_images[i].get_width();
+            uint32_t layer_height = hdr ? params.m_source_images_hdr[i].get_height() : params.m_source_images[i].get_height();
+            if (layer_width != width || layer_height != height) {
+                task->set_status(ConversionTask::FAILED);
+                task->set_error(ERR_INVALID_DATA);
+                task->set_error_message("Image size differs from the first layer: " + source_paths[i]);
+                return;
+            }
+        }
+
+        int layout = options.get("layout", (int)ConversionTask::LAYOUT_2D_ARRAY);
+        if (layout == ConversionTask::LAYOUT_CUBEMAP) {
+            if (source_count % 6 != 0 || width != height) {
+                task->set_status(ConversionTask::FAILED);
+                task->set_error(ERR_INVALID_PARAMETER);
+                task->set_error_message("A cubemap needs six square faces per layer");
+                return;
+            }
+            params.m_tex_type = basist::cBASISTexTypeCubemapArray;
+        } else {
+            params.m_tex_type = basist::cBASISTexType2DArray;
+        }
     }
 
-    // Setup basis encoder parameters
-    basisu::basis_compressor_params params;
-    params.m_pJob_pool = basis_job_pool;
-    params.m_source_images.push_back(img);
+    // Encode stage: everything from here to the compressed output runs on encoder threads
+    job_pool = lease.acquire();
+    params.m_pJob_pool = job_pool;
 
-    // Use UASTC mode for better quality
-    params.m_uastc = true;
-    params.m_pack_uastc_ldr_4x4_flags = uastc_level;
+    // Downscale before encoding; layers share one size, so they share one target
+    ImageResize::Settings resize = resize_settings(options);
+    for (size_t i = 0; i < source_count && !task->is_cancel_requested(); i++) {
+        uint32_t width = hdr ? params.m_source_images_hdr[i].get_width() : params.m_source_images[i].get_width();
+        uint32_t height = hdr ? params.m_source_images_hdr[i].get_height() : params.m_source_images[i].get_height();
+        uint32_t target_width, target_height;
+        ImageResize::target_size(resize, width, height, target_width, target_height);
+        if (target_width == width && target_height == height) {
+            continue;
+        }
 
-    // KTX2 output settings
-    params.m_create_ktx2_file = true;
-    params.m_ktx2_uastc_supercompression = basist::KTX2_SS_ZSTANDARD;
-    params.m_ktx2_zstd_supercompression_level = 6;  // Moderate compression
+        bool resized;
+        if (hdr) {
+            basisu::imagef img;
+            resized = ImageResize::resample(params.m_source_images_hdr[i], img, target_width, target_height, job_pool,
+                    task->get_cancel_token());
+            params.m_source_images_hdr[i].swap(img);
+        } else {
+            basisu::image img;
+            resized = ImageResize::resample(params.m_source_images[i], img, target_width, target_height, true, job_pool,
+                    task->get_cancel_token());
+            params.m_source_images[i].swap(img);
+        }
+        if (!resized && !task->is_cancel_requested()) {
+            task->set_status(ConversionTask::FAILED);
+            task->set_error(FAILED);
+            task->set_error_message("Failed to resize image: " + source_paths[i]);
+            return;
+        }
+    }
 
-    // Mipmap settings
-    if (mipmaps) {
-        params.m_mip_gen = true;
-        params.m_mip_filter = "kaiser";
-    } else {
-        params.m_mip_gen = false;
+    // Check for cancellation
+    if (task->is_cancel_requested()) {
+        return;
     }
 
-    // Disable status output for library use
-    params.m_status_output = false;
+    task->set_progress(0.4f);
+    _report_progress(task);
+
+    // Setup basis encoder parameters
+    apply_encoder_options(params, options, hdr);
 
     // Check for cancellation
-    if (task->get_status() == ConversionTask::CANCELLED) {
+    if (task->is_cancel_requested()) {
         return;
     }
 
     task->set_progress(0.5f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
 
     // Create and run the compressor
     basisu::basis_compressor compressor;
@@ -377,7 +1108,7 @@ void AssetConverter::_convert_image_to_ktx2(Ref<ConversionTask> task) {
     }
 
     task->set_progress(0.6f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
 
     // Compress
     basisu::basis_compressor::error_code result = compressor.process();
@@ -388,34 +1119,42 @@ void AssetConverter::_convert_image_to_ktx2(Ref<ConversionTask> task) {
         return;
     }
 
+    // The write stage does not need encoder threads
+    lease.release();
+
     // Check for cancellation
-    if (task->get_status() == ConversionTask::CANCELLED) {
+    if (task->is_cancel_requested()) {
         return;
     }
 
     task->set_progress(0.9f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
 
-    // Get the output data
+    // Write straight from the compressor's buffer
     const basisu::uint8_vec &output_data = compressor.get_output_ktx2_file();
 
-    // Write to file
-    std::vector<uint8_t> output_vec(output_data.begin(), output_data.end());
-    if (!write_vector_to_file(output_path, output_vec)) {
+    OutputFile outfile(output_path);
+    if (!outfile.open() ||
+        !outfile.stream().write(reinterpret_cast<const char*>(output_data.data()), output_data.size()) ||
+        !outfile.commit()) {
         task->set_status(ConversionTask::FAILED);
         task->set_error(ERR_FILE_CANT_WRITE);
         task->set_error_message("Failed to write output file");
         return;
     }
 
+    if (!cache_key.empty()) {
+        conversion_cache.store(cache_key, output_path);
+    }
+
     // Success
     task->set_status(ConversionTask::COMPLETED);
     task->set_error(OK);
     task->set_progress(1.0f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
 }
 
-void AssetConverter::_convert_audio_to_mp3(Ref<ConversionTask> task) {
+void AssetConverter::_convert_audio_to_mp3(Ref<ConversionTask> task, EncoderLease &lease) {
     CharString source_utf8 = task->get_source_path().utf8();
     CharString output_utf8 = task->get_output_path().utf8();
     const char *source_path = source_utf8.get_data();
@@ -423,9 +1162,10 @@ void AssetConverter::_convert_audio_to_mp3(Ref<ConversionTask> task) {
 
     Dictionary options = task->get_options();
     int bitrate = options.get("bitrate", 192);
+    bool parallel_segments = options.get("parallel_segments", false);
 
     task->set_progress(0.1f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
 
     // Only WAV input is supported
     String lower_path = task->get_source_path().to_lower();
@@ -449,137 +1189,227 @@ void AssetConverter::_convert_audio_to_mp3(Ref<ConversionTask> task) {
     unsigned int sample_rate = wav.sampleRate;
     drwav_uint64 total_frame_count = wav.totalPCMFrameCount;
 
-    // Read all samples as 16-bit PCM
-    int16_t *pcm_samples = (int16_t *)malloc(sizeof(int16_t) * total_frame_count * channels);
-    if (!pcm_samples) {
-        drwav_uninit(&wav);
-        task->set_status(ConversionTask::FAILED);
-        task->set_error(ERR_OUT_OF_MEMORY);
-        task->set_error_message("Failed to allocate memory for audio samples");
-        return;
-    }
+    Mp3SegmentEncoder::Settings settings;
+    settings.source_path = source_path;
+    settings.channels = (int)channels;
+    settings.sample_rate = (int)sample_rate;
+    settings.bitrate = bitrate;
+    settings.cancel_token = task->get_cancel_token();
 
-    drwav_uint64 frames_read = drwav_read_pcm_frames_s16(&wav, total_frame_count, pcm_samples);
-    drwav_uninit(&wav);
+    // LAME reads the WAV as it encodes, so the encode stage covers the rest of the task
+    basisu::job_pool *job_pool = lease.acquire();
 
-    if (frames_read != total_frame_count) {
-        ::free(pcm_samples);
-        task->set_status(ConversionTask::FAILED);
-        task->set_error(ERR_FILE_CORRUPT);
-        task->set_error_message("Failed to read all audio frames");
-        return;
+    // Long inputs can be split into segments encoded in parallel (opt-in)
+    uint64_t segment_count = 1;
+    if (parallel_segments && sample_rate > 0) {
+        segment_count = MIN((uint64_t)job_pool->get_total_threads(), total_frame_count / (MIN_MP3_SEGMENT_SECONDS * sample_rate));
     }
-
-    // Check for cancellation
-    if (task->get_status() == ConversionTask::CANCELLED) {
-        ::free(pcm_samples);
+    int frame_samples, encoder_delay;
+    if (segment_count > 1 && Mp3SegmentEncoder::probe(settings, frame_samples, encoder_delay)) {
+        drwav_uninit(&wav);
+        _convert_audio_to_mp3_segmented(task, job_pool, settings, (int)segment_count, frame_samples, encoder_delay);
         return;
     }
 
-    task->set_progress(0.3f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
-
     // Initialize LAME encoder
     lame_t lame = lame_init();
     if (!lame) {
-        ::free(pcm_samples);
+        drwav_uninit(&wav);
         task->set_status(ConversionTask::FAILED);
         task->set_error(FAILED);
         task->set_error_message("Failed to initialize LAME encoder");
         return;
     }
 
-    lame_set_num_channels(lame, channels);
-    lame_set_in_samplerate(lame, sample_rate);
-    lame_set_brate(lame, bitrate);
-    lame_set_mode(lame, channels == 1 ? MONO : JOINT_STEREO);
-    lame_set_quality(lame, 2); // 2 = high quality, slower
-
-    if (lame_init_params(lame) < 0) {
+    if (!Mp3SegmentEncoder::configure(lame, settings, false, true)) {
         lame_close(lame);
-        ::free(pcm_samples);
+        drwav_uninit(&wav);
         task->set_status(ConversionTask::FAILED);
         task->set_error(FAILED);
         task->set_error_message("Failed to configure LAME encoder");
         return;
     }
 
-    // Check for cancellation
-    if (task->get_status() == ConversionTask::CANCELLED) {
+    OutputFile outfile(output_path);
+    if (!outfile.open()) {
         lame_close(lame);
-        ::free(pcm_samples);
+        drwav_uninit(&wav);
+        task->set_status(ConversionTask::FAILED);
+        task->set_error(ERR_FILE_CANT_WRITE);
+        task->set_error_message("Failed to create output MP3 file");
         return;
     }
 
-    task->set_progress(0.4f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    // Stream fixed-size blocks through the encoder so memory use does not grow with
+    // input length. MP3 buffer worst case per LAME docs: 1.25 * frames + 7200 bytes.
+    std::vector<int16_t> pcm_samples(AUDIO_CHUNK_FRAMES * channels);
+    std::vector<unsigned char> mp3_buffer((size_t)(1.25 * AUDIO_CHUNK_FRAMES) + 7200);
+    drwav_uint64 frames_encoded = 0;
 
-    // Allocate MP3 buffer (worst case: 1.25 * samples + 7200)
-    size_t mp3_buffer_size = (size_t)(1.25 * total_frame_count * channels) + 7200;
-    unsigned char *mp3_buffer = (unsigned char *)malloc(mp3_buffer_size);
-    if (!mp3_buffer) {
-        lame_close(lame);
-        ::free(pcm_samples);
+    while (frames_encoded < total_frame_count) {
+        // Check for cancellation
+        if (task->is_cancel_requested()) {
+            lame_close(lame);
+            drwav_uninit(&wav);
+            return;
+        }
+
+        drwav_uint64 frames_to_read = MIN((drwav_uint64)AUDIO_CHUNK_FRAMES, total_frame_count - frames_encoded);
+        drwav_uint64 frames_read = drwav_read_pcm_frames_s16(&wav, frames_to_read, pcm_samples.data());
+        if (frames_read == 0) {
+            lame_close(lame);
+            drwav_uninit(&wav);
+            task->set_status(ConversionTask::FAILED);
+            task->set_error(ERR_FILE_CORRUPT);
+            task->set_error_message("Failed to read all audio frames");
+            return;
+        }
+
+        // Encode
+        int mp3_size;
+        if (channels == 1) {
+            // Mono
+            mp3_size = lame_encode_buffer(lame, pcm_samples.data(), nullptr, (int)frames_read, mp3_buffer.data(), (int)mp3_buffer.size());
+        } else {
+            // Stereo - interleaved
+            mp3_size = lame_encode_buffer_interleaved(lame, pcm_samples.data(), (int)frames_read, mp3_buffer.data(), (int)mp3_buffer.size());
+        }
+
+        if (mp3_size < 0) {
+            lame_close(lame);
+            drwav_uninit(&wav);
+            task->set_status(ConversionTask::FAILED);
+            task->set_error(FAILED);
+            task->set_error_message("LAME encoding failed with error: " + String::num_int64(mp3_size));
+            return;
+        }
+
+        outfile.stream().write(reinterpret_cast<const char*>(mp3_buffer.data()), mp3_size);
+        frames_encoded += frames_read;
+
+        float progress = 0.1f + 0.85f * ((float)frames_encoded / (float)total_frame_count);
+        task->set_progress(progress);
+        _report_progress(task);
+    }
+
+    drwav_uninit(&wav);
+
+    // Flush encoder
+    int flush_size = lame_encode_flush(lame, mp3_buffer.data(), (int)mp3_buffer.size());
+    if (flush_size > 0) {
+        outfile.stream().write(reinterpret_cast<const char*>(mp3_buffer.data()), flush_size);
+    }
+
+    // Replace the placeholder first frame with the final LAME tag (frame count, size, gapless info)
+    std::vector<unsigned char> tag_frame(lame_get_lametag_frame(lame, nullptr, 0));
+    if (!tag_frame.empty() && lame_get_lametag_frame(lame, tag_frame.data(), tag_frame.size()) == tag_frame.size()) {
+        outfile.stream().seekp(0);
+        outfile.stream().write(reinterpret_cast<const char*>(tag_frame.data()), tag_frame.size());
+    }
+
+    lame_close(lame);
+
+    if (!outfile.commit()) {
         task->set_status(ConversionTask::FAILED);
-        task->set_error(ERR_OUT_OF_MEMORY);
-        task->set_error_message("Failed to allocate MP3 buffer");
+        task->set_error(ERR_FILE_CANT_WRITE);
+        task->set_error_message("Failed to write MP3 data");
         return;
     }
 
-    // Encode
-    int mp3_size;
-    if (channels == 1) {
-        // Mono
-        mp3_size = lame_encode_buffer(lame, pcm_samples, nullptr, (int)total_frame_count, mp3_buffer, (int)mp3_buffer_size);
-    } else {
-        // Stereo - interleaved
-        mp3_size = lame_encode_buffer_interleaved(lame, pcm_samples, (int)total_frame_count, mp3_buffer, (int)mp3_buffer_size);
-    }
+    // Success
+    task->set_status(ConversionTask::COMPLETED);
+    task->set_error(OK);
+    task->set_progress(1.0f);
+    _report_progress(task);
+}
 
-    ::free(pcm_samples);
+void AssetConverter::_convert_audio_to_mp3_segmented(Ref<ConversionTask> task, basisu::job_pool *job_pool,
+        Mp3SegmentEncoder::Settings settings, int segment_count, int frame_samples, int encoder_delay) {
+    CharString output_utf8 = task->get_output_path().utf8();
+    const char *output_path = output_utf8.get_data();
 
-    if (mp3_size < 0) {
-        lame_close(lame);
-        ::free(mp3_buffer);
+    drwav wav;
+    if (!drwav_init_file(&wav, settings.source_path, nullptr)) {
         task->set_status(ConversionTask::FAILED);
-        task->set_error(FAILED);
-        task->set_error_message("LAME encoding failed with error: " + String::num_int64(mp3_size));
+        task->set_error(ERR_FILE_CANT_OPEN);
+        task->set_error_message("Failed to open WAV file");
         return;
     }
+    uint64_t total_samples = wav.totalPCMFrameCount;
+    drwav_uninit(&wav);
+
+    // Split on MP3 frame boundaries; the last segment takes the remainder
+    uint64_t total_mp3_frames = (total_samples + frame_samples - 1) / frame_samples;
+    uint64_t frames_per_segment = total_mp3_frames / segment_count;
+    std::vector<Mp3SegmentEncoder::Segment> segments(segment_count);
+    for (int i = 0; i < segment_count; i++) {
+        segments[i].first_frame = i * frames_per_segment;
+        segments[i].frame_count = frames_per_segment;
+        segments[i].is_first = i == 0;
+        segments[i].is_last = i == segment_count - 1;
+    }
+
+    // Progress over all segments (serialized so reported values stay monotonic)
+    std::mutex progress_mutex;
+    uint64_t samples_encoded = 0;
+    settings.on_samples_encoded = [&](uint64_t count) {
+        std::lock_guard<std::mutex> lock(progress_mutex);
+        samples_encoded += count;
+        float progress = 0.1f + 0.85f * ((float)samples_encoded / (float)total_samples);
+        task->set_progress(progress);
+        _report_progress(task);
+    };
+
+    for (int i = 0; i < segment_count; i++) {
+        job_pool->add_job([&, i]() {
+            // Check for cancellation
+            if (task->is_cancel_requested()) {
+                return;
+            }
+            Mp3SegmentEncoder::encode_segment(settings, frame_samples, segments[i]);
+        });
+    }
+    job_pool->wait_for_all();
 
     // Check for cancellation
-    if (task->get_status() == ConversionTask::CANCELLED) {
-        lame_close(lame);
-        ::free(mp3_buffer);
+    if (task->is_cancel_requested()) {
         return;
     }
 
-    task->set_progress(0.8f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
-
-    // Flush encoder
-    int flush_size = lame_encode_flush(lame, mp3_buffer + mp3_size, (int)(mp3_buffer_size - mp3_size));
-    if (flush_size > 0) {
-        mp3_size += flush_size;
+    uint64_t music_bytes = 0;
+    uint32_t music_frames = 0;
+    uint16_t music_crc = 0;
+    for (const Mp3SegmentEncoder::Segment &segment : segments) {
+        if (!segment.error.empty()) {
+            task->set_status(ConversionTask::FAILED);
+            task->set_error(FAILED);
+            task->set_error_message(String(segment.error.c_str()));
+            return;
+        }
+        music_bytes += segment.frames.size();
+        music_frames += segment.kept_frames;
+        music_crc = Mp3SegmentEncoder::crc16(segment.frames.data(), segment.frames.size(), music_crc);
     }
 
-    lame_close(lame);
+    // Describe the stitched stream in the first segment's LAME tag
+    std::vector<uint8_t> &tag_frame = segments[0].tag_frame;
+    int encoder_padding = (int)((uint64_t)music_frames * frame_samples - total_samples - encoder_delay);
+    Mp3SegmentEncoder::finalize_tag_frame(tag_frame, music_frames, music_bytes, music_crc, encoder_delay, encoder_padding);
 
-    // Write MP3 file
-    std::ofstream outfile(output_path, std::ios::binary);
-    if (!outfile.is_open()) {
-        ::free(mp3_buffer);
+    OutputFile outfile(output_path);
+    if (!outfile.open()) {
         task->set_status(ConversionTask::FAILED);
         task->set_error(ERR_FILE_CANT_WRITE);
         task->set_error_message("Failed to create output MP3 file");
         return;
     }
 
-    outfile.write(reinterpret_cast<const char*>(mp3_buffer), mp3_size);
-    outfile.close();
-    ::free(mp3_buffer);
+    outfile.stream().write(reinterpret_cast<const char*>(tag_frame.data()), tag_frame.size());
+    for (const Mp3SegmentEncoder::Segment &segment : segments) {
+        outfile.stream().write(reinterpret_cast<const char*>(segment.frames.data()), segment.frames.size());
+    }
 
-    if (!outfile.good()) {
+    if (!outfile.commit()) {
         task->set_status(ConversionTask::FAILED);
         task->set_error(ERR_FILE_CANT_WRITE);
         task->set_error_message("Failed to write MP3 data");
@@ -589,53 +1419,183 @@ void AssetConverter::_convert_audio_to_mp3(Ref<ConversionTask> task) {
     // Success
     task->set_status(ConversionTask::COMPLETED);
     task->set_error(OK);
+    task->set_segment_count(segment_count);
     task->set_progress(1.0f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
+}
+
+// What a GLB image is sampled as. When an image has several roles the highest one
+// wins, so a texture shared by normals and occlusion is still encoded as a normal map.
+enum TextureRole {
+    TEXTURE_ROLE_UNUSED,    // Not referenced by any material; encoded like color
+    TEXTURE_ROLE_OCCLUSION, // Occlusion only: linear, encoded with less effort
+    TEXTURE_ROLE_LINEAR,    // Metallic-roughness/ORM and other non-color data
+    TEXTURE_ROLE_COLOR,     // Base color, emissive and other sRGB color
+    TEXTURE_ROLE_NORMAL,    // Tangent-space normal map
+};
+
+static void assign_texture_role(const cgltf_data *data, const cgltf_texture_view &view, TextureRole role,
+        std::vector<TextureRole> &r_roles) {
+    if (!view.texture) {
+        return;
+    }
+    const cgltf_image *images[2] = { view.texture->image, view.texture->basisu_image };
+    for (const cgltf_image *image : images) {
+        if (image) {
+            TextureRole &current = r_roles[image - data->images];
+            current = MAX(current, role);
+        }
+    }
+}
+
+// Work out each image's role from the materials that sample it
+static std::vector<TextureRole> classify_texture_roles(const cgltf_data *data) {
+    std::vector<TextureRole> roles(data->images_count, TEXTURE_ROLE_UNUSED);
+    for (size_t i = 0; i < data->materials_count; i++) {
+        const cgltf_material &material = data->materials[i];
+
+        assign_texture_role(data, material.normal_texture, TEXTURE_ROLE_NORMAL, roles);
+        assign_texture_role(data, material.occlusion_texture, TEXTURE_ROLE_OCCLUSION, roles);
+        assign_texture_role(data, material.emissive_texture, TEXTURE_ROLE_COLOR, roles);
+        if (material.has_pbr_metallic_roughness) {
+            assign_texture_role(data, material.pbr_metallic_roughness.base_color_texture, TEXTURE_ROLE_COLOR, roles);
+            assign_texture_role(data, material.pbr_metallic_roughness.metallic_roughness_texture, TEXTURE_ROLE_LINEAR, roles);
+        }
+        if (material.has_pbr_specular_glossiness) {
+            assign_texture_role(data, material.pbr_specular_glossiness.diffuse_texture, TEXTURE_ROLE_COLOR, roles);
+            assign_texture_role(data, material.pbr_specular_glossiness.specular_glossiness_texture, TEXTURE_ROLE_COLOR, roles);
+        }
+        if (material.has_clearcoat) {
+            assign_texture_role(data, material.clearcoat.clearcoat_texture, TEXTURE_ROLE_LINEAR, roles);
+            assign_texture_role(data, material.clearcoat.clearcoat_roughness_texture, TEXTURE_ROLE_LINEAR, roles);
+            assign_texture_role(data, material.clearcoat.clearcoat_normal_texture, TEXTURE_ROLE_NORMAL, roles);
+        }
+        if (material.has_specular) {
+            assign_texture_role(data, material.specular.specular_texture, TEXTURE_ROLE_LINEAR, roles);
+            assign_texture_role(data, material.specular.specular_color_texture, TEXTURE_ROLE_COLOR, roles);
+        }
+        if (material.has_sheen) {
+            assign_texture_role(data, material.sheen.sheen_color_texture, TEXTURE_ROLE_COLOR, roles);
+            assign_texture_role(data, material.sheen.sheen_roughness_texture, TEXTURE_ROLE_LINEAR, roles);
+        }
+        if (material.has_transmission) {
+            assign_texture_role(data, material.transmission.transmission_texture, TEXTURE_ROLE_LINEAR, roles);
+        }
+        if (material.has_volume) {
+            assign_texture_role(data, material.volume.thickness_texture, TEXTURE_ROLE_LINEAR, roles);
+        }
+        if (material.has_anisotropy) {
+            assign_texture_role(data, material.anisotropy.anisotropy_texture, TEXTURE_ROLE_LINEAR, roles);
+        }
+    }
+    return roles;
+}
+
+// Adjust the encoder settings from apply_encoder_options() for an image's role
+static void apply_texture_role(basisu::basis_compressor_params &params, TextureRole role, const Dictionary &options) {
+    bool etc1s = (int)options.get("encoder", (int)ConversionTask::ENCODER_UASTC) == ConversionTask::ENCODER_ETC1S;
+
+    switch (role) {
+        case TEXTURE_ROLE_NORMAL:
+            // Linear metrics and mip filtering, renormalized mips, no RDO on the selectors
+            params.m_perceptual = false;
+            params.m_mip_srgb = false;
+            params.m_mip_renormalize = true;
+            params.m_ktx2_srgb_transfer_func = false;
+            if (etc1s) {
+                params.m_no_selector_rdo = true;
+                params.m_no_endpoint_rdo = true;
+            }
+            break;
+
+        case TEXTURE_ROLE_OCCLUSION: {
+            // Low-frequency data: one effort level below the requested one is enough
+            int quality = options.get("quality", 128);
+            if (etc1s) {
+                int compression_level = CLAMP((int)options.get("compression_level", 2), 0, 6);
+                params.m_compression_level = MAX(0, compression_level - 1);
+            } else {
+                uint32_t uastc_level = quality_to_uastc_level(quality);
+                params.m_pack_uastc_ldr_4x4_flags = uastc_level > basisu::cPackUASTCLevelFastest ? uastc_level - 1 : uastc_level;
+            }
+            params.m_perceptual = false;
+            params.m_mip_srgb = false;
+            params.m_ktx2_srgb_transfer_func = false;
+            break;
+        }
+
+        case TEXTURE_ROLE_LINEAR:
+            params.m_perceptual = false;
+            params.m_mip_srgb = false;
+            params.m_ktx2_srgb_transfer_func = false;
+            break;
+
+        case TEXTURE_ROLE_COLOR:
+        case TEXTURE_ROLE_UNUSED:
+            params.m_perceptual = true;
+            params.m_mip_srgb = true;
+            params.m_ktx2_srgb_transfer_func = true;
+            break;
+    }
 }
 
 // Helper structure to hold converted texture data
 struct ConvertedTexture {
-    std::vector<uint8_t> ktx2_data;
+    SharedTextureCache::Blob ktx2_data;
     size_t original_buffer_view_index;
+    size_t canonical_image; // First image with the same payload (itself if unique)
     bool converted;
 };
 
-void AssetConverter::_convert_glb_textures_to_ktx2(Ref<ConversionTask> task) {
+void AssetConverter::_convert_glb_textures_to_ktx2(Ref<ConversionTask> task, EncoderLease &lease) {
     CharString source_utf8 = task->get_source_path().utf8();
     const char *source_path = source_utf8.get_data();
 
     Dictionary options = task->get_options();
     int quality = options.get("quality", 128);
     bool mipmaps = options.get("mipmaps", true);
+    bool keep_fallback = options.get("keep_fallback", false);
     String output_path = task->get_output_path();
 
-    // If no output path specified, create one based on source
-    if (output_path.is_empty()) {
-        output_path = task->get_source_path().get_basename() + "_ktx2.glb";
-        task->set_output_path(output_path);
+    // glTF textures are 8-bit; KHR_texture_basisu has no HDR variant
+    if (is_hdr_encoder(options.get("encoder", (int)ConversionTask::ENCODER_UASTC))) {
+        task->set_status(ConversionTask::FAILED);
+        task->set_error(ERR_INVALID_PARAMETER);
+        task->set_error_message("HDR encoders are not supported for GLB textures");
+        return;
     }
 
     task->set_progress(0.1f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
 
-    // Read entire GLB file
-    std::vector<uint8_t> glb_data;
-    if (!read_file_to_vector(source_path, glb_data)) {
+    // Map the GLB file. cgltf parses it in place and points buffer 0 at the mapped
+    // BIN chunk, so the file is never copied to the heap.
+    MappedFile glb_file;
+    if (!glb_file.open(source_path)) {
         task->set_status(ConversionTask::FAILED);
         task->set_error(ERR_FILE_CANT_OPEN);
         task->set_error_message("Failed to read GLB file");
         return;
     }
+    const uint8_t *glb_data = glb_file.data();
+    size_t glb_size = glb_file.size();
+
+    // Reuse a previous output for identical source bytes and options
+    CharString output_utf8 = output_path.utf8();
+    std::string cache_key = _get_cache_key(task, glb_data, glb_size);
+    if (_complete_from_cache(task, cache_key, output_utf8.get_data())) {
+        return;
+    }
 
     // Validate GLB header
-    if (glb_data.size() < 12) {
+    if (glb_size < 12) {
         task->set_status(ConversionTask::FAILED);
         task->set_error(ERR_INVALID_DATA);
         task->set_error_message("Invalid GLB file: too small");
         return;
     }
 
-    uint32_t magic = *(uint32_t*)glb_data.data();
+    uint32_t magic = *(uint32_t*)glb_data;
     uint32_t version = *(uint32_t*)&glb_data[4];
     // uint32_t total_length = *(uint32_t*)&glb_data[8];
 
@@ -657,7 +1617,7 @@ void AssetConverter::_convert_glb_textures_to_ktx2(Ref<ConversionTask> task) {
     size_t offset = 12;
 
     // JSON chunk
-    if (offset + 8 > glb_data.size()) {
+    if (offset + 8 > glb_size) {
         task->set_status(ConversionTask::FAILED);
         task->set_error(ERR_INVALID_DATA);
         task->set_error_message("Invalid GLB: missing JSON chunk");
@@ -675,28 +1635,21 @@ void AssetConverter::_convert_glb_textures_to_ktx2(Ref<ConversionTask> task) {
     }
 
     offset += 8;
-    std::string json_str((char*)&glb_data[offset], json_chunk_length);
-    offset += json_chunk_length;
-
-    // BIN chunk (optional)
-    std::vector<uint8_t> bin_data;
-    if (offset + 8 <= glb_data.size()) {
-        uint32_t bin_chunk_length = *(uint32_t*)&glb_data[offset];
-        uint32_t bin_chunk_type = *(uint32_t*)&glb_data[offset + 4];
-
-        if (bin_chunk_type == 0x004E4942) { // "BIN\0"
-            offset += 8;
-            bin_data.assign(glb_data.begin() + offset, glb_data.begin() + offset + bin_chunk_length);
-        }
+    if (offset + json_chunk_length > glb_size) {
+        task->set_status(ConversionTask::FAILED);
+        task->set_error(ERR_INVALID_DATA);
+        task->set_error_message("Invalid GLB: truncated JSON chunk");
+        return;
     }
+    const char *json_chunk = (const char*)&glb_data[offset];
 
     task->set_progress(0.15f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
 
     // Parse with cgltf to get structure info
     cgltf_options cgltf_opts = {};
     cgltf_data *data = nullptr;
-    cgltf_result parse_result = cgltf_parse(&cgltf_opts, glb_data.data(), glb_data.size(), &data);
+    cgltf_result parse_result = cgltf_parse(&cgltf_opts, glb_data, glb_size, &data);
 
     if (parse_result != cgltf_result_success) {
         task->set_status(ConversionTask::FAILED);
@@ -715,13 +1668,13 @@ void AssetConverter::_convert_glb_textures_to_ktx2(Ref<ConversionTask> task) {
     }
 
     // Check for cancellation
-    if (task->get_status() == ConversionTask::CANCELLED) {
+    if (task->is_cancel_requested()) {
         cgltf_free(data);
         return;
     }
 
     task->set_progress(0.2f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
 
     int total_images = (int)data->images_count;
     if (total_images == 0) {
@@ -730,104 +1683,152 @@ void AssetConverter::_convert_glb_textures_to_ktx2(Ref<ConversionTask> task) {
         task->set_error(OK);
         task->set_progress(1.0f);
         task->set_error_message("No textures found in GLB file");
-        call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+        _report_progress(task);
         return;
     }
 
-    // Map quality to UASTC level
-    uint32_t uastc_level;
-    if (quality <= 50) {
-        uastc_level = basisu::cPackUASTCLevelFastest;
-    } else if (quality <= 100) {
-        uastc_level = basisu::cPackUASTCLevelFaster;
-    } else if (quality <= 150) {
-        uastc_level = basisu::cPackUASTCLevelDefault;
-    } else if (quality <= 200) {
-        uastc_level = basisu::cPackUASTCLevelSlower;
-    } else {
-        uastc_level = basisu::cPackUASTCLevelVerySlow;
-    }
-
-    // Convert each image and store the KTX2 data
+    // Convert each image and store the KTX2 data. Images with identical payloads are
+    // encoded once: later copies point at the first one and share its KTX2 blob.
+    // Each image is encoded with the profile of its role in the materials.
+    std::shared_ptr<SharedTextureCache> shared_textures = _get_shared_textures(task);
+    std::vector<TextureRole> texture_roles = classify_texture_roles(data);
     std::vector<ConvertedTexture> converted_textures(data->images_count);
-    int textures_converted = 0;
-
+    std::vector<std::string> texture_keys(data->images_count);
+    std::unordered_map<std::string, size_t> first_image_by_key;
+    ImageResize::Settings resize = resize_settings(options);
+    std::vector<size_t> embedded_images;
     for (size_t i = 0; i < data->images_count; i++) {
         converted_textures[i].converted = false;
-
-        // Check for cancellation
-        if (task->get_status() == ConversionTask::CANCELLED) {
-            cgltf_free(data);
-            return;
+        converted_textures[i].canonical_image = i;
+
+        // External images are left untouched
+        const cgltf_buffer_view *buffer_view = data->images[i].buffer_view;
+        if (buffer_view) {
+            converted_textures[i].original_buffer_view_index = buffer_view - data->buffer_views;
+            char texture_options[160];
+            snprintf(texture_options, sizeof(texture_options), "encoder %d quality %d level %d mipmaps %d role %d size %u scale %g pow2 %d",
+                    (int)options.get("encoder", (int)ConversionTask::ENCODER_UASTC), quality,
+                    (int)options.get("compression_level", 2), mipmaps ? 1 : 0, (int)texture_roles[i],
+                    resize.max_size, (double)resize.scale, resize.pow2 ? 1 : 0);
+            texture_keys[i] = SharedTextureCache::make_key(
+                    (const uint8_t *)buffer_view->buffer->data + buffer_view->offset, buffer_view->size, texture_options);
+            auto inserted = first_image_by_key.emplace(texture_keys[i], i);
+            if (inserted.second) {
+                embedded_images.push_back(i);
+            } else {
+                converted_textures[i].canonical_image = inserted.first->second;
+            }
         }
+    }
 
-        cgltf_image *image = &data->images[i];
+    // Encode stage. Reading and parsing the GLB above and rewriting it below run without
+    // encoder threads.
+    basisu::job_pool *job_pool = lease.acquire();
 
-        // Get image data
-        const uint8_t *image_data = nullptr;
-        size_t image_size = 0;
+    // Decode and encode every embedded image as an independent job on this task's pool.
+    // A job cannot hand the task pool to its own compressor (wait_for_all() from inside
+    // a job would wait on itself), so each compressor borrows an idle pool from the budget
+    // sized to an even split of the task's threads.
+    uint32_t pool_threads = job_pool->get_total_threads();
+    uint32_t image_threads = MAX(1u, pool_threads / (uint32_t)MAX((size_t)1, embedded_images.size()));
 
-        if (image->buffer_view) {
-            image_data = (const uint8_t *)image->buffer_view->buffer->data + image->buffer_view->offset;
-            image_size = image->buffer_view->size;
-            converted_textures[i].original_buffer_view_index = image->buffer_view - data->buffer_views;
-        } else if (image->uri) {
-            // External image - skip
-            continue;
-        } else {
-            continue;
-        }
+    std::mutex progress_mutex;
+    int images_done = 0;
 
-        // Load image using stb_image (supports PNG, JPEG, BMP, TGA, GIF, PSD, HDR, PIC)
-        int width, height, channels;
-        uint8_t *decoded_data = stbi_load_from_memory(
-            image_data, (int)image_size,
-            &width, &height, &channels, 4);  // Force RGBA output
+    for (size_t i : embedded_images) {
+        job_pool->add_job([&, i]() {
+            ConvertedTexture &converted = converted_textures[i];
 
-        if (!decoded_data) {
-            continue;
-        }
+            // Check for cancellation
+            if (task->is_cancel_requested()) {
+                return;
+            }
 
-        basisu::image img;
-        img.resize(width, height);
-        memcpy(img.get_ptr(), decoded_data, width * height * 4);
-        stbi_image_free(decoded_data);
+            // Another GLB of the batch may already have encoded the same payload
+            SharedTextureCache::Blob shared_blob;
+            if (shared_textures && !shared_textures->acquire(texture_keys[i], shared_blob)) {
+                converted.ktx2_data = shared_blob;
+                converted.converted = shared_blob != nullptr;
+                if (converted.converted) {
+                    shared_texture_reuse_count++;
+                }
+            } else {
+                const cgltf_buffer_view *buffer_view = data->images[i].buffer_view;
+                const uint8_t *image_data = (const uint8_t *)buffer_view->buffer->data + buffer_view->offset;
+                size_t image_size = buffer_view->size;
+
+                // A cancel lands between the stages of a running job too: each stage holds
+                // the job's threads, and only basisu's own encode cannot be interrupted
+                basisu::image img;
+                String decode_error;
+                if (decode_image_ldr(image_data, image_size, img, decode_error) && !task->is_cancel_requested()) {
+                    basisu::job_pool *image_job_pool = EncoderThreadBudget::take_pool((int)image_threads);
+
+                    // Downscale before encoding; only color data is filtered in linear light
+                    uint32_t target_width, target_height;
+                    ImageResize::target_size(resize, img.get_width(), img.get_height(), target_width, target_height);
+                    if (target_width != img.get_width() || target_height != img.get_height()) {
+                        bool srgb = texture_roles[i] == TEXTURE_ROLE_COLOR || texture_roles[i] == TEXTURE_ROLE_UNUSED;
+                        basisu::image resized;
+                        if (ImageResize::resample(img, resized, target_width, target_height, srgb, image_job_pool,
+                                    task->get_cancel_token())) {
+                            img.swap(resized);
+                        }
+                    }
 
-        // Setup basis encoder
-        basisu::basis_compressor_params params;
-        params.m_pJob_pool = basis_job_pool;
-        params.m_source_images.push_back(img);
-        params.m_uastc = true;
-        params.m_pack_uastc_ldr_4x4_flags = uastc_level;
-        params.m_create_ktx2_file = true;
-        params.m_ktx2_uastc_supercompression = basist::KTX2_SS_ZSTANDARD;
-        params.m_ktx2_zstd_supercompression_level = 6;
-        params.m_mip_gen = mipmaps;
-        if (mipmaps) {
-            params.m_mip_filter = "kaiser";
-        }
-        params.m_status_output = false;
+                    // Setup basis encoder
+                    basisu::basis_compressor_params params;
+                    params.m_pJob_pool = image_job_pool;
+                    params.m_source_images.resize(1);
+                    params.m_source_images[0].swap(img);
+                    apply_encoder_options(params, options);
+                    apply_texture_role(params, texture_roles[i], options);
+
+                    basisu::basis_compressor compressor;
+                    if (!task->is_cancel_requested() && compressor.init(params) &&
+                            compressor.process() == basisu::basis_compressor::cECSuccess) {
+                        // Store converted data
+                        const basisu::uint8_vec &ktx2_output = compressor.get_output_ktx2_file();
+                        converted.ktx2_data = std::make_shared<const std::vector<uint8_t>>(ktx2_output.begin(), ktx2_output.end());
+                        converted.converted = true;
+                    }
+                    EncoderThreadBudget::return_pool(image_job_pool);
+                }
 
-        basisu::basis_compressor compressor;
-        if (!compressor.init(params)) {
-            continue;
-        }
+                // Always publish, so jobs waiting on this payload are released even on failure
+                if (shared_textures) {
+                    shared_textures->publish(texture_keys[i], converted.ktx2_data);
+                }
+            }
 
-        basisu::basis_compressor::error_code result = compressor.process();
-        if (result != basisu::basis_compressor::cECSuccess) {
-            continue;
-        }
+            // Update progress (serialized so reported values stay monotonic)
+            std::lock_guard<std::mutex> lock(progress_mutex);
+            images_done++;
+            float progress = 0.2f + (0.5f * ((float)images_done / (float)embedded_images.size()));
+            task->set_progress(progress);
+            _report_progress(task);
+        });
+    }
+    job_pool->wait_for_all();
+    lease.release();
 
-        // Store converted data
-        const basisu::uint8_vec &ktx2_output = compressor.get_output_ktx2_file();
-        converted_textures[i].ktx2_data.assign(ktx2_output.begin(), ktx2_output.end());
-        converted_textures[i].converted = true;
-        textures_converted++;
+    // Check for cancellation
+    if (task->is_cancel_requested()) {
+        cgltf_free(data);
+        return;
+    }
 
-        // Update progress
-        float progress = 0.2f + (0.5f * ((float)(i + 1) / (float)total_images));
-        task->set_progress(progress);
-        call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    // Duplicates take the result of the first image with the same payload
+    int textures_converted = 0;
+    for (size_t i = 0; i < data->images_count; i++) {
+        ConvertedTexture &converted = converted_textures[i];
+        if (converted.canonical_image != i) {
+            converted.ktx2_data = converted_textures[converted.canonical_image].ktx2_data;
+            converted.converted = converted_textures[converted.canonical_image].converted;
+        }
+        if (converted.converted) {
+            textures_converted++;
+        }
     }
 
     if (textures_converted == 0) {
@@ -839,11 +1840,20 @@ void AssetConverter::_convert_glb_textures_to_ktx2(Ref<ConversionTask> task) {
     }
 
     task->set_progress(0.75f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
-
-    // Build new binary buffer with converted textures
-    // First, copy non-image data from original buffer
-    std::vector<uint8_t> new_bin_data;
+    _report_progress(task);
+
+    // Lay out the new binary buffer: non-image buffer views first, then the images
+    // (converted or original), each aligned to 4 bytes. Duplicate images are stored
+    // once and their buffer views all point at the same range. Only offsets and sizes
+    // are computed here; the bytes are written straight from their sources below.
+    struct BinPiece {
+        const uint8_t *data;
+        size_t size;
+        size_t offset;
+    };
+    std::vector<BinPiece> bin_pieces;
+    bin_pieces.reserve(data->buffer_views_count + data->images_count);
+    size_t new_bin_size = 0;
 
     // Track which buffer view ranges are used by images
     std::vector<bool> is_image_buffer_view(data->buffer_views_count, false);
@@ -854,226 +1864,179 @@ void AssetConverter::_convert_glb_textures_to_ktx2(Ref<ConversionTask> task) {
         }
     }
 
-    // Build mapping of old buffer view offsets to new offsets
-    std::vector<size_t> new_buffer_view_offsets(data->buffer_views_count);
-    std::vector<size_t> new_buffer_view_sizes(data->buffer_views_count);
+    // New buffer view offsets and sizes, collected straight into the JSON patch
+    GltfJsonRewriter::Patch json_patch;
+    std::vector<uint64_t> &new_buffer_view_offsets = json_patch.buffer_view_offsets;
+    std::vector<uint64_t> &new_buffer_view_sizes = json_patch.buffer_view_sizes;
+    new_buffer_view_offsets.resize(data->buffer_views_count);
+    new_buffer_view_sizes.resize(data->buffer_views_count);
 
-    // Copy non-image buffer views first
+    auto add_bin_piece = [&](size_t bv_idx, const uint8_t *src, size_t size) {
+        // Align to 4 bytes
+        new_bin_size = (new_bin_size + 3) & ~(size_t)3;
+        new_buffer_view_offsets[bv_idx] = new_bin_size;
+        new_buffer_view_sizes[bv_idx] = size;
+        bin_pieces.push_back({ src, size, new_bin_size });
+        new_bin_size += size;
+    };
+
+    // Non-image buffer views first
     for (size_t i = 0; i < data->buffer_views_count; i++) {
         if (!is_image_buffer_view[i]) {
             cgltf_buffer_view *bv = &data->buffer_views[i];
-            // Align to 4 bytes
-            while (new_bin_data.size() % 4 != 0) {
-                new_bin_data.push_back(0);
-            }
-            new_buffer_view_offsets[i] = new_bin_data.size();
-            new_buffer_view_sizes[i] = bv->size;
-
-            const uint8_t *src = (const uint8_t*)bv->buffer->data + bv->offset;
-            new_bin_data.insert(new_bin_data.end(), src, src + bv->size);
+            add_bin_piece(i, (const uint8_t*)bv->buffer->data + bv->offset, bv->size);
         }
     }
 
-    // Now add converted texture data
+    // Now add converted texture data, keeping original data for non-converted images.
+    // With a fallback, converted images keep their original data too and each unique
+    // KTX2 payload becomes a new image behind a new buffer view after the existing ones.
+    std::vector<int64_t> ktx2_image_index(data->images_count, -1);
+    size_t added_images = 0;
     for (size_t i = 0; i < data->images_count; i++) {
-        if (converted_textures[i].converted && data->images[i].buffer_view) {
-            size_t bv_idx = data->images[i].buffer_view - data->buffer_views;
+        if (converted_textures[i].converted && converted_textures[i].canonical_image == i) {
+            ktx2_image_index[i] = keep_fallback ? (int64_t)(data->images_count + added_images++) : (int64_t)i;
+        }
+    }
+    new_buffer_view_offsets.resize(data->buffer_views_count + added_images);
+    new_buffer_view_sizes.resize(data->buffer_views_count + added_images);
 
-            // Align to 4 bytes
-            while (new_bin_data.size() % 4 != 0) {
-                new_bin_data.push_back(0);
+    for (size_t i = 0; i < data->images_count; i++) {
+        if (!data->images[i].buffer_view) {
+            continue;
+        }
+        size_t bv_idx = data->images[i].buffer_view - data->buffer_views;
+        size_t canonical = converted_textures[i].canonical_image;
+        if (canonical != i) {
+            size_t canonical_bv_idx = converted_textures[canonical].original_buffer_view_index;
+            new_buffer_view_offsets[bv_idx] = new_buffer_view_offsets[canonical_bv_idx];
+            new_buffer_view_sizes[bv_idx] = new_buffer_view_sizes[canonical_bv_idx];
+            if (keep_fallback || ktx2_image_index[canonical] < 0) {
+                ktx2_image_index[i] = ktx2_image_index[canonical];
+            } else {
+                ktx2_image_index[i] = (int64_t)i; // Now KTX2 itself, sharing the canonical's range
             }
-
-            new_buffer_view_offsets[bv_idx] = new_bin_data.size();
-            new_buffer_view_sizes[bv_idx] = converted_textures[i].ktx2_data.size();
-
-            new_bin_data.insert(new_bin_data.end(),
-                converted_textures[i].ktx2_data.begin(),
-                converted_textures[i].ktx2_data.end());
-        } else if (data->images[i].buffer_view) {
-            // Keep original data for non-converted images
-            size_t bv_idx = data->images[i].buffer_view - data->buffer_views;
+        } else if (converted_textures[i].converted && !keep_fallback) {
+            add_bin_piece(bv_idx, converted_textures[i].ktx2_data->data(), converted_textures[i].ktx2_data->size());
+        } else {
             cgltf_buffer_view *bv = &data->buffer_views[bv_idx];
+            add_bin_piece(bv_idx, (const uint8_t*)bv->buffer->data + bv->offset, bv->size);
+        }
+    }
 
-            while (new_bin_data.size() % 4 != 0) {
-                new_bin_data.push_back(0);
+    if (keep_fallback) {
+        for (size_t i = 0; i < data->images_count; i++) {
+            if (converted_textures[i].canonical_image == i && ktx2_image_index[i] >= 0) {
+                size_t bv_idx = data->buffer_views_count + (size_t)(ktx2_image_index[i] - (int64_t)data->images_count);
+                add_bin_piece(bv_idx, converted_textures[i].ktx2_data->data(), converted_textures[i].ktx2_data->size());
+                json_patch.added_ktx2_images.push_back(bv_idx);
             }
-
-            new_buffer_view_offsets[bv_idx] = new_bin_data.size();
-            new_buffer_view_sizes[bv_idx] = bv->size;
-
-            const uint8_t *src = (const uint8_t*)bv->buffer->data + bv->offset;
-            new_bin_data.insert(new_bin_data.end(), src, src + bv->size);
         }
     }
 
     // Pad to 4-byte alignment
-    while (new_bin_data.size() % 4 != 0) {
-        new_bin_data.push_back(0);
-    }
+    new_bin_size = (new_bin_size + 3) & ~(size_t)3;
 
     task->set_progress(0.85f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
-
-    // Modify JSON to update buffer views and mime types
-    // We'll do simple string replacements for the buffer view sizes/offsets and mime types
-    std::string new_json = json_str;
+    _report_progress(task);
 
-    // Update mime types for converted images
+    // Regenerate the JSON with the new buffer view ranges and BIN size. Textures of
+    // converted images reference the KTX2 image through KHR_texture_basisu.
+    json_patch.bin_size = new_bin_size;
+    json_patch.keep_fallback = keep_fallback;
+    json_patch.image_is_ktx2.resize(data->images_count);
     for (size_t i = 0; i < data->images_count; i++) {
-        if (converted_textures[i].converted) {
-            cgltf_image *image = &data->images[i];
-            if (image->mime_type) {
-                // Replace old mime type with KTX2
-                std::string old_mime = image->mime_type;
-                // Find and replace in context of this image
-                size_t pos = 0;
-                while ((pos = new_json.find(old_mime, pos)) != std::string::npos) {
-                    // Check if this is likely within an image definition
-                    size_t context_start = (pos > 50) ? pos - 50 : 0;
-                    std::string context = new_json.substr(context_start, pos - context_start);
-                    if (context.find("\"mimeType\"") != std::string::npos ||
-                        context.find("\"uri\"") != std::string::npos ||
-                        context.find("\"bufferView\"") != std::string::npos) {
-                        new_json.replace(pos, old_mime.length(), "image/ktx2");
-                        pos += 10; // length of "image/ktx2"
-                    } else {
-                        pos += old_mime.length();
-                    }
-                }
-            }
-        }
+        json_patch.image_is_ktx2[i] = converted_textures[i].converted && !keep_fallback;
     }
-
-    // Update buffer view byte lengths
-    for (size_t i = 0; i < data->buffer_views_count; i++) {
-        cgltf_buffer_view *bv = &data->buffer_views[i];
-        if (new_buffer_view_sizes[i] != bv->size) {
-            // Find this buffer view in JSON and update byteLength
-            char old_len[64], new_len[64];
-            snprintf(old_len, sizeof(old_len), "\"byteLength\":%zu", (size_t)bv->size);
-            snprintf(new_len, sizeof(new_len), "\"byteLength\":%zu", new_buffer_view_sizes[i]);
-
-            size_t pos = new_json.find(old_len);
-            if (pos != std::string::npos) {
-                new_json.replace(pos, strlen(old_len), new_len);
-            }
-
-            // Also try with space after colon
-            snprintf(old_len, sizeof(old_len), "\"byteLength\": %zu", (size_t)bv->size);
-            pos = new_json.find(old_len);
-            if (pos != std::string::npos) {
-                snprintf(new_len, sizeof(new_len), "\"byteLength\": %zu", new_buffer_view_sizes[i]);
-                new_json.replace(pos, strlen(old_len), new_len);
-            }
-        }
-
-        if (new_buffer_view_offsets[i] != bv->offset) {
-            char old_off[64], new_off[64];
-            snprintf(old_off, sizeof(old_off), "\"byteOffset\":%zu", (size_t)bv->offset);
-            snprintf(new_off, sizeof(new_off), "\"byteOffset\":%zu", new_buffer_view_offsets[i]);
-
-            size_t pos = new_json.find(old_off);
-            if (pos != std::string::npos) {
-                new_json.replace(pos, strlen(old_off), new_off);
-            }
-
-            snprintf(old_off, sizeof(old_off), "\"byteOffset\": %zu", (size_t)bv->offset);
-            pos = new_json.find(old_off);
-            if (pos != std::string::npos) {
-                snprintf(new_off, sizeof(new_off), "\"byteOffset\": %zu", new_buffer_view_offsets[i]);
-                new_json.replace(pos, strlen(old_off), new_off);
-            }
+    json_patch.texture_basisu_sources.assign(data->textures_count, -1);
+    for (size_t i = 0; i < data->textures_count; i++) {
+        if (data->textures[i].image) {
+            json_patch.texture_basisu_sources[i] = ktx2_image_index[data->textures[i].image - data->images];
         }
     }
 
-    // Update main buffer byteLength
-    if (data->buffers_count > 0) {
-        char old_buf_len[64], new_buf_len[64];
-        snprintf(old_buf_len, sizeof(old_buf_len), "\"byteLength\":%zu", (size_t)data->buffers[0].size);
-        snprintf(new_buf_len, sizeof(new_buf_len), "\"byteLength\":%zu", new_bin_data.size());
-
-        // This is tricky - we need to find the buffer's byteLength, not a bufferView's
-        // Look for it in the "buffers" array context
-        size_t buffers_pos = new_json.find("\"buffers\"");
-        if (buffers_pos != std::string::npos) {
-            size_t search_start = buffers_pos;
-            size_t pos = new_json.find(old_buf_len, search_start);
-            if (pos != std::string::npos && pos < buffers_pos + 200) {
-                new_json.replace(pos, strlen(old_buf_len), new_buf_len);
-            } else {
-                snprintf(old_buf_len, sizeof(old_buf_len), "\"byteLength\": %zu", (size_t)data->buffers[0].size);
-                pos = new_json.find(old_buf_len, search_start);
-                if (pos != std::string::npos && pos < buffers_pos + 200) {
-                    snprintf(new_buf_len, sizeof(new_buf_len), "\"byteLength\": %zu", new_bin_data.size());
-                    new_json.replace(pos, strlen(old_buf_len), new_buf_len);
-                }
-            }
-        }
+    std::string new_json;
+    if (!GltfJsonRewriter::rewrite(json_chunk, json_chunk_length, json_patch, new_json)) {
+        cgltf_free(data);
+        task->set_status(ConversionTask::FAILED);
+        task->set_error(ERR_INVALID_DATA);
+        task->set_error_message("Failed to rewrite GLB JSON");
+        return;
     }
 
-    cgltf_free(data);
-
     // Pad JSON to 4-byte alignment
     while (new_json.size() % 4 != 0) {
         new_json.push_back(' ');
     }
 
     task->set_progress(0.9f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
 
     // Write new GLB file
-    CharString output_utf8 = output_path.utf8();
-    std::ofstream outfile(output_utf8.get_data(), std::ios::binary);
-    if (!outfile.is_open()) {
+    OutputFile outfile(output_utf8.get_data());
+    if (!outfile.open()) {
+        cgltf_free(data);
         task->set_status(ConversionTask::FAILED);
         task->set_error(ERR_FILE_CANT_WRITE);
         task->set_error_message("Failed to create output GLB file");
         return;
     }
+    std::ofstream &out = outfile.stream();
 
     // Calculate total length
     uint32_t json_chunk_len = (uint32_t)new_json.size();
-    uint32_t bin_chunk_len = (uint32_t)new_bin_data.size();
+    uint32_t bin_chunk_len = (uint32_t)new_bin_size;
     uint32_t total_len = 12 + 8 + json_chunk_len + 8 + bin_chunk_len;
 
     // Write header
     uint32_t glb_magic = 0x46546C67; // "glTF"
     uint32_t glb_version = 2;
-    outfile.write((char*)&glb_magic, 4);
-    outfile.write((char*)&glb_version, 4);
-    outfile.write((char*)&total_len, 4);
+    out.write((char*)&glb_magic, 4);
+    out.write((char*)&glb_version, 4);
+    out.write((char*)&total_len, 4);
 
     // Write JSON chunk
     uint32_t json_type = 0x4E4F534A; // "JSON"
-    outfile.write((char*)&json_chunk_len, 4);
-    outfile.write((char*)&json_type, 4);
-    outfile.write(new_json.data(), json_chunk_len);
+    out.write((char*)&json_chunk_len, 4);
+    out.write((char*)&json_type, 4);
+    out.write(new_json.data(), json_chunk_len);
 
-    // Write BIN chunk
+    // Write BIN chunk piece by piece, zero-padding the alignment gaps
+    static const char zero_padding[4] = { 0, 0, 0, 0 };
     uint32_t bin_type = 0x004E4942; // "BIN\0"
-    outfile.write((char*)&bin_chunk_len, 4);
-    outfile.write((char*)&bin_type, 4);
-    outfile.write((char*)new_bin_data.data(), bin_chunk_len);
+    out.write((char*)&bin_chunk_len, 4);
+    out.write((char*)&bin_type, 4);
+    size_t bin_written = 0;
+    for (const BinPiece &piece : bin_pieces) {
+        out.write(zero_padding, piece.offset - bin_written);
+        out.write((const char*)piece.data, piece.size);
+        bin_written = piece.offset + piece.size;
+    }
+    out.write(zero_padding, new_bin_size - bin_written);
 
-    outfile.close();
+    // The pieces point into the mapped source and cgltf's buffers
+    cgltf_free(data);
 
-    if (!outfile.good()) {
+    if (!outfile.commit()) {
         task->set_status(ConversionTask::FAILED);
         task->set_error(ERR_FILE_CANT_WRITE);
         task->set_error_message("Failed to write GLB file");
         return;
     }
 
+    if (!cache_key.empty()) {
+        conversion_cache.store(cache_key, output_utf8.get_data());
+    }
+
     // Success
     task->set_status(ConversionTask::COMPLETED);
     task->set_error(OK);
     task->set_error_message("Converted " + String::num_int64(textures_converted) + " textures to KTX2 in GLB");
     task->set_progress(1.0f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
 }
 
-void AssetConverter::_normalize_audio(Ref<ConversionTask> task) {
+void AssetConverter::_normalize_audio(Ref<ConversionTask> task, EncoderLease &lease) {
     CharString source_utf8 = task->get_source_path().utf8();
     CharString output_utf8 = task->get_output_path().utf8();
     const char *source_path = source_utf8.get_data();
@@ -1084,7 +2047,7 @@ void AssetConverter::_normalize_audio(Ref<ConversionTask> task) {
     float peak_limit_db = options.get("peak_limit_db", -1.0f);
 
     task->set_progress(0.1f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
 
     // Only WAV input is supported
     String lower_path = task->get_source_path().to_lower();
@@ -1129,13 +2092,16 @@ void AssetConverter::_normalize_audio(Ref<ConversionTask> task) {
     }
 
     // Check for cancellation
-    if (task->get_status() == ConversionTask::CANCELLED) {
+    if (task->is_cancel_requested()) {
         ::free(samples);
         return;
     }
 
     task->set_progress(0.3f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
+
+    // Processing stage: the read above and the write below run without encoder threads
+    lease.acquire();
 
     // Calculate current peak
     size_t total_samples = total_frame_count * channels;
@@ -1148,13 +2114,13 @@ void AssetConverter::_normalize_audio(Ref<ConversionTask> task) {
     }
 
     // Check for cancellation
-    if (task->get_status() == ConversionTask::CANCELLED) {
+    if (task->is_cancel_requested()) {
         ::free(samples);
         return;
     }
 
     task->set_progress(0.5f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
 
     // Calculate gain needed for normalization
     // target_db is the target peak level in dB (e.g., -14 dB)
@@ -1184,13 +2150,13 @@ void AssetConverter::_normalize_audio(Ref<ConversionTask> task) {
     }
 
     // Check for cancellation
-    if (task->get_status() == ConversionTask::CANCELLED) {
+    if (task->is_cancel_requested()) {
         ::free(samples);
         return;
     }
 
     task->set_progress(0.7f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
 
     // Convert float samples to 16-bit PCM for WAV output
     int16_t *pcm_samples = (int16_t *)malloc(sizeof(int16_t) * total_samples);
@@ -1210,9 +2176,10 @@ void AssetConverter::_normalize_audio(Ref<ConversionTask> task) {
     }
 
     ::free(samples);
+    lease.release();
 
     task->set_progress(0.8f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
 
     // Write output WAV file
     drwav_data_format format;
@@ -1222,8 +2189,9 @@ void AssetConverter::_normalize_audio(Ref<ConversionTask> task) {
     format.sampleRate = sample_rate;
     format.bitsPerSample = 16;
 
+    OutputFile outfile(output_path);
     drwav wav_out;
-    if (!drwav_init_file_write(&wav_out, output_path, &format, nullptr)) {
+    if (!drwav_init_file_write(&wav_out, outfile.get_temp_path(), &format, nullptr)) {
         ::free(pcm_samples);
         task->set_status(ConversionTask::FAILED);
         task->set_error(ERR_FILE_CANT_WRITE);
@@ -1235,7 +2203,7 @@ void AssetConverter::_normalize_audio(Ref<ConversionTask> task) {
     drwav_uninit(&wav_out);
     ::free(pcm_samples);
 
-    if (frames_written != total_frame_count) {
+    if (frames_written != total_frame_count || !outfile.commit()) {
         task->set_status(ConversionTask::FAILED);
         task->set_error(ERR_FILE_CANT_WRITE);
         task->set_error_message("Failed to write all audio frames");
@@ -1246,118 +2214,312 @@ void AssetConverter::_normalize_audio(Ref<ConversionTask> task) {
     task->set_status(ConversionTask::COMPLETED);
     task->set_error(OK);
     task->set_progress(1.0f);
-    call_deferred("_emit_progress", task->get_id(), task->get_source_path(), task->get_progress());
+    _report_progress(task);
 }
 
 // Public async methods
 
-int AssetConverter::image_to_ktx2(const String &source_path, const String &output_path, int quality, bool mipmaps) {
-    Ref<ConversionTask> task = ConversionTask::create_image_to_ktx2(source_path, output_path, quality, mipmaps);
-
+void AssetConverter::_enqueue_task(const Ref<ConversionTask> &task) {
     queue_mutex->lock();
     task->set_id(next_task_id++);
-    task_queue.push_back(task);
+    unfinished_count++;
     queue_mutex->unlock();
 
+    active_mutex->lock();
+    active_tasks[task->get_id()] = task;
+    active_mutex->unlock();
+
+    task_queue.push(task, (int64_t)Time::get_singleton()->get_ticks_usec());
     work_semaphore->post();
+}
+
+int AssetConverter::image_to_ktx2(const String &source_path, const String &output_path, int quality, bool mipmaps,
+        ConversionTask::Encoder encoder, int compression_level, int max_size, float scale, bool pow2, ConversionTask::Priority priority) {
+    Ref<ConversionTask> task = ConversionTask::create_image_to_ktx2(source_path, output_path, quality, mipmaps, encoder, compression_level,
+            max_size, scale, pow2);
+    task->set_priority(priority);
+
+    _enqueue_task(task);
 
     return task->get_id();
 }
 
-int AssetConverter::audio_to_mp3(const String &source_path, const String &output_path, int bitrate) {
-    Ref<ConversionTask> task = ConversionTask::create_audio_to_mp3(source_path, output_path, bitrate);
-
-    queue_mutex->lock();
-    task->set_id(next_task_id++);
-    task_queue.push_back(task);
-    queue_mutex->unlock();
+int AssetConverter::images_to_ktx2(const PackedStringArray &source_paths, const String &output_path,
+        ConversionTask::TextureLayout layout, int quality, bool mipmaps, ConversionTask::Encoder encoder, int compression_level,
+        int max_size, float scale, bool pow2, ConversionTask::Priority priority) {
+    Ref<ConversionTask> task = ConversionTask::create_images_to_ktx2(source_paths, output_path, layout, quality, mipmaps,
+            encoder, compression_level, max_size, scale, pow2);
+    task->set_priority(priority);
 
-    work_semaphore->post();
+    _enqueue_task(task);
 
     return task->get_id();
 }
 
-int AssetConverter::glb_textures_to_ktx2(const String &source_path, const String &output_path, int quality, bool mipmaps) {
-    Ref<ConversionTask> task = ConversionTask::create_glb_textures_to_ktx2(source_path, output_path, quality, mipmaps);
+int AssetConverter::audio_to_mp3(const String &source_path, const String &output_path, int bitrate, bool parallel_segments,
+        ConversionTask::Priority priority) {
+    Ref<ConversionTask> task = ConversionTask::create_audio_to_mp3(source_path, output_path, bitrate, parallel_segments);
+    task->set_priority(priority);
 
-    queue_mutex->lock();
-    task->set_id(next_task_id++);
-    task_queue.push_back(task);
-    queue_mutex->unlock();
+    _enqueue_task(task);
 
-    work_semaphore->post();
+    return task->get_id();
+}
+
+int AssetConverter::glb_textures_to_ktx2(const String &source_path, const String &output_path, int quality, bool mipmaps,
+        bool keep_fallback, ConversionTask::Encoder encoder, int compression_level, int max_size, float scale, bool pow2,
+        ConversionTask::Priority priority) {
+    Ref<ConversionTask> task = ConversionTask::create_glb_textures_to_ktx2(source_path, output_path, quality, mipmaps,
+            keep_fallback, encoder, compression_level, max_size, scale, pow2);
+    task->set_priority(priority);
+
+    _enqueue_task(task);
 
     return task->get_id();
 }
 
-int AssetConverter::normalize_audio(const String &source_path, const String &output_path, float target_db, float peak_limit_db) {
+int AssetConverter::normalize_audio(const String &source_path, const String &output_path, float target_db, float peak_limit_db,
+        ConversionTask::Priority priority) {
     Ref<ConversionTask> task = ConversionTask::create_normalize_audio(source_path, output_path, target_db, peak_limit_db);
+    task->set_priority(priority);
 
-    queue_mutex->lock();
-    task->set_id(next_task_id++);
-    task_queue.push_back(task);
-    queue_mutex->unlock();
-
-    work_semaphore->post();
+    _enqueue_task(task);
 
     return task->get_id();
 }
 
-void AssetConverter::convert_batch(const TypedArray<ConversionTask> &tasks) {
-    queue_mutex->lock();
-    is_batch_mode = true;
-    batch_results.clear();
-
+int AssetConverter::convert_batch(const TypedArray<ConversionTask> &tasks) {
+    std::vector<Ref<ConversionTask>> ordered;
+    std::vector<Ref<ConversionTask>> up_to_date;
+    ordered.reserve(tasks.size());
     for (const auto &variant : tasks) {
         Ref<ConversionTask> task = variant;
-        if (task.is_valid()) {
-            task->set_id(next_task_id++);
-            task_queue.push_back(task);
+        if (task.is_null()) {
+            continue;
+        }
+        // In incremental mode an unchanged task completes here: it never enters the
+        // queue or emits task signals, and only appears in the batch results
+        if (_is_up_to_date(task)) {
+            task->set_output_path(resolve_output_path(task));
+            task->set_status(ConversionTask::COMPLETED);
+            task->set_error(OK);
+            task->set_error_message("Output is up to date");
+            task->set_progress(1.0f);
+            up_to_date.push_back(task);
+        } else {
+            ordered.push_back(task);
         }
     }
-    queue_mutex->unlock();
 
-    // Signal for each task
-    for (int i = 0; i < tasks.size(); i++) {
-        work_semaphore->post();
+    // Estimate every task from its file headers (image dimensions, WAV frames, GLB
+    // image views) before queueing, so estimated_cost is set while the batch can still
+    // be ordered by it
+    for (const Ref<ConversionTask> &task : ordered) {
+        if (task->get_estimated_cost() < 0.0f) {
+            task->set_estimated_cost(estimate_task_cost(task));
+        }
     }
-}
 
-bool AssetConverter::cancel(int task_id) {
+    // Order by estimated cost. Longest-first keeps one large texture from starting
+    // last and leaving the other workers idle at the end.
+    if (scheduling_policy != SCHEDULE_FIFO) {
+        bool longest_first = scheduling_policy == SCHEDULE_LONGEST_FIRST;
+        std::stable_sort(ordered.begin(), ordered.end(),
+            [longest_first](const Ref<ConversionTask> &a, const Ref<ConversionTask> &b) {
+                return longest_first ? a->get_estimated_cost() > b->get_estimated_cost()
+                                     : a->get_estimated_cost() < b->get_estimated_cost();
+            });
+    }
+
+    int64_t now_usec = (int64_t)Time::get_singleton()->get_ticks_usec();
     queue_mutex->lock();
-    for (auto &task : task_queue) {
-        if (task->get_id() == task_id) {
-            task->set_status(ConversionTask::CANCELLED);
-            task->set_error(ERR_SKIP);
-            task->set_error_message("Task cancelled");
-            queue_mutex->unlock();
-            return true;
-        }
+    int batch_id = next_batch_id++;
+    Array results;
+    for (const Ref<ConversionTask> &task : up_to_date) {
+        task->set_id(next_task_id++);
+        task->set_batch_id(batch_id);
+        results.push_back(batch_result(task));
+    }
+    int total = (int)(ordered.size() + up_to_date.size());
+    if (ordered.empty()) {
+        // Nothing will finish to complete it, so report the batch right away
+        queue_mutex->unlock();
+        call_deferred("_emit_batch_progress", batch_id, total, total, (int64_t)0, (int64_t)0, 0.0f);
+        call_deferred("_emit_batch_completed", batch_id, results);
+        return batch_id;
+    }
+    // Up-to-date tasks count as done from the start, without bytes
+    batches[batch_id] = Batch{ (int)ordered.size(), results, std::make_shared<SharedTextureCache>(),
+            total, (int)up_to_date.size(), 0, 0, now_usec };
+
+    for (const Ref<ConversionTask> &task : ordered) {
+        task->set_id(next_task_id++);
+        task->set_batch_id(batch_id);
     }
+    unfinished_count += (int)ordered.size();
     queue_mutex->unlock();
-    return false;
+
+    active_mutex->lock();
+    for (const Ref<ConversionTask> &task : ordered) {
+        active_tasks[task->get_id()] = task;
+    }
+    active_mutex->unlock();
+
+    // Queue and signal each task; the deques lock individually, so workers keep popping
+    for (const Ref<ConversionTask> &task : ordered) {
+        task_queue.push(task, now_usec);
+        work_semaphore->post();
+    }
+
+    return batch_id;
 }
 
-void AssetConverter::cancel_all() {
-    queue_mutex->lock();
-    for (auto &task : task_queue) {
-        task->set_status(ConversionTask::CANCELLED);
+// Flag a task, then take it if no worker has claimed it yet. A queued task taken here is
+// skipped when a worker pops it; a claimed one stops at the converter's next check (or
+// right after the claim) and reports itself as cancelled.
+static void cancel_task(const Ref<ConversionTask> &task) {
+    task->request_cancel();
+    if (task->try_set_status(ConversionTask::PENDING, ConversionTask::CANCELLED)) {
         task->set_error(ERR_SKIP);
         task->set_error_message("Task cancelled");
     }
-    queue_mutex->unlock();
+}
+
+bool AssetConverter::cancel(int task_id) {
+    active_mutex->lock();
+    auto it = active_tasks.find(task_id);
+    bool active = it != active_tasks.end();
+    if (active) {
+        cancel_task(it->second);
+    }
+    active_mutex->unlock();
+    return active;
+}
+
+void AssetConverter::cancel_all() {
+    active_mutex->lock();
+    for (const auto &entry : active_tasks) {
+        cancel_task(entry.second);
+    }
+    active_mutex->unlock();
 }
 
 bool AssetConverter::is_running() const {
     queue_mutex->lock();
-    bool running = !task_queue.is_empty();
+    bool running = unfinished_count > 0;
     queue_mutex->unlock();
     return running;
 }
 
 int AssetConverter::get_pending_count() const {
+    return task_queue.size();
+}
+
+Dictionary AssetConverter::get_queue_wait_stats() const {
+    Dictionary stats;
+    for (int lane = 0; lane < TaskQueue::LANE_COUNT; lane++) {
+        TaskQueue::WaitStats wait = task_queue.get_wait_stats((ConversionTask::Priority)lane);
+        Dictionary entry;
+        entry["tasks"] = wait.tasks;
+        entry["average_wait"] = wait.tasks > 0 ? (double)wait.total_usec / (double)wait.tasks / 1.0e6 : 0.0;
+        entry["max_wait"] = (double)wait.max_usec / 1.0e6;
+        stats[lane] = entry;
+    }
+    return stats;
+}
+
+void AssetConverter::reset_queue_wait_stats() {
+    task_queue.reset_wait_stats();
+}
+
+void AssetConverter::set_worker_count(int p_count) {
+    if (p_count <= 0) {
+        p_count = default_worker_count();
+    }
+    p_count = MIN(p_count, TaskQueue::MAX_WORKERS);
+    if (p_count == worker_count) {
+        return;
+    }
+
+    // Resize without waiting for running tasks. Surplus workers retire after their current
+    // task; new workers start on free indices (joining any retired thread still holding one).
     queue_mutex->lock();
-    int count = task_queue.size();
+    int previous = worker_count;
+    worker_count = p_count;
+    task_queue.set_worker_count(p_count);
+    std::vector<int> to_start;
+    for (int i = 0; i < p_count; i++) {
+        if (worker_threads[i].is_null() || worker_retired[i]) {
+            to_start.push_back(i);
+        }
+    }
     queue_mutex->unlock();
-    return count;
+
+    for (int i : to_start) {
+        _start_worker(i);
+    }
+
+    // Wake idle surplus workers so they retire now rather than at the next task
+    for (int i = p_count; i < previous; i++) {
+        work_semaphore->post();
+    }
+}
+
+int AssetConverter::get_worker_count() const {
+    return worker_count;
+}
+
+void AssetConverter::set_max_threads(int p_count) {
+    EncoderThreadBudget::set_max_threads(MAX(0, p_count));
+}
+
+int AssetConverter::get_max_threads() {
+    return EncoderThreadBudget::get_max_threads();
+}
+
+void AssetConverter::set_cache_directory(const String &p_path) {
+    // Accept res:// and user:// paths as well as absolute ones
+    String path = p_path.is_empty() ? String() : ProjectSettings::get_singleton()->globalize_path(p_path);
+    CharString path_utf8 = path.utf8();
+    conversion_cache.set_directory(path_utf8.get_data());
+}
+
+String AssetConverter::get_cache_directory() {
+    return String::utf8(conversion_cache.get_directory().c_str());
+}
+
+void AssetConverter::set_cache_max_size(int64_t p_bytes) {
+    conversion_cache.set_max_size((uint64_t)MAX((int64_t)0, p_bytes));
+}
+
+int64_t AssetConverter::get_cache_max_size() {
+    return (int64_t)conversion_cache.get_max_size();
+}
+
+int64_t AssetConverter::get_cache_hit_count() const {
+    return (int64_t)conversion_cache.get_hit_count();
+}
+
+int64_t AssetConverter::get_cache_miss_count() const {
+    return (int64_t)conversion_cache.get_miss_count();
+}
+
+int64_t AssetConverter::get_shared_texture_reuse_count() const {
+    return shared_texture_reuse_count.load();
+}
+
+void AssetConverter::set_incremental(bool p_enabled) {
+    incremental = p_enabled;
+}
+
+bool AssetConverter::is_incremental() const {
+    return incremental;
+}
+
+void AssetConverter::set_scheduling_policy(SchedulingPolicy p_policy) {
+    scheduling_policy = p_policy;
+}
+
+AssetConverter::SchedulingPolicy AssetConverter::get_scheduling_policy() const {
+    return scheduling_policy;
 }
@@ -1,7 +1,14 @@
 #ifndef ASSET_CONVERTER_H
 #define ASSET_CONVERTER_H
 
+#include "batch_manifest.h"
+#include "conversion_cache.h"
 #include "conversion_task.h"
+#include "encoder_thread_budget.h"
+#include "mp3_segment_encoder.h"
+#include "progress_table.h"
+#include "shared_texture_cache.h"
+#include "task_queue.h"
 
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/classes/thread.hpp>
@@ -13,6 +20,10 @@
 #include <godot_cpp/variant/string.hpp>
 #include <godot_cpp/templates/vector.hpp>
 
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+
 // Forward declaration for basis job pool
 namespace basisu { class job_pool; }
 
@@ -21,39 +32,115 @@ namespace godot {
 class AssetConverter : public RefCounted {
     GDCLASS(AssetConverter, RefCounted)
 
+public:
+    // Order in which convert_batch() hands tasks to the workers
+    enum SchedulingPolicy {
+        SCHEDULE_FIFO,
+        SCHEDULE_LONGEST_FIRST,
+        SCHEDULE_SHORTEST_FIRST
+    };
+
 private:
-    // Task queue
-    Vector<Ref<ConversionTask>> task_queue;
+    // Task queue (per-worker deques) and lock for task IDs and batch state
+    TaskQueue task_queue;
     Ref<Mutex> queue_mutex;
 
-    // Worker thread
-    Ref<Thread> worker_thread;
+    // Worker threads by worker index. Workers at or above worker_count retire after their
+    // current task; their threads are joined when the index is reused or on shutdown.
+    std::vector<Ref<Thread>> worker_threads;
+    std::vector<uint8_t> worker_retired; // Protected by queue_mutex
     Ref<Semaphore> work_semaphore;
+    // Slots for tasks reading and decoding ahead of the encoders (see EncoderLease)
+    Ref<Semaphore> readahead_slots;
     bool should_exit;
-    bool is_batch_mode;
+    int worker_count; // Protected by queue_mutex
+
+    // Tasks queued or running (protected by queue_mutex)
+    int unfinished_count;
+
+    // Tasks queued or running, by task ID, so cancel() can reach a task wherever it is.
+    // Guarded by its own lock: workers pop from task_queue without any converter lock.
+    Ref<Mutex> active_mutex;
+    std::unordered_map<int, Ref<ConversionTask>> active_tasks;
 
     // Task ID counter
     int next_task_id;
 
-    // Batch results
-    Array batch_results;
-
-    // Basis Universal job pool for texture compression
-    basisu::job_pool *basis_job_pool;
+    // Batches queued with convert_batch() that still have unfinished tasks, by batch ID
+    // (protected by queue_mutex). Each completes on its own, independent of other work.
+    struct Batch {
+        int remaining;
+        Array results;
+        // KTX2 textures encoded so far by the batch's GLBs, reused for identical images
+        std::shared_ptr<SharedTextureCache> shared_textures;
+        // Totals for batch_progress
+        int total;
+        int done;
+        int64_t bytes_in;
+        int64_t bytes_out;
+        int64_t start_usec;
+    };
+    std::unordered_map<int, Batch> batches;
+    int next_batch_id;
+    SchedulingPolicy scheduling_policy;
+
+    // Content-addressed output cache (disabled until a directory is set)
+    ConversionCache conversion_cache;
+
+    // GLB images taken from another GLB of the same batch instead of encoded again
+    std::atomic<int64_t> shared_texture_reuse_count;
+
+    // Incremental mode: skip tasks recorded as up to date in the output manifests
+    std::atomic<bool> incremental;
+    BatchManifest batch_manifest;
+
+    // Progress published by the workers, drained on the main thread at a capped rate
+    ProgressTable progress_table;
+    bool frame_pump_connected;
+
+    // Main thread: tasks whose started signal has been emitted, and the last progress sent
+    struct EmittedTask {
+        String source_path;
+        float progress;
+    };
+    std::unordered_map<int, EmittedTask> emitted_tasks;
 
     // Internal methods
-    void _worker_function();
-    void _process_task(Ref<ConversionTask> task);
+    void _start_worker(int worker_index);
+    void _stop_workers();
+    bool _retire_worker(int worker_index);
+    void _worker_function(int worker_index);
+    void _enqueue_task(const Ref<ConversionTask> &task);
+    // Record a finished task and the bytes it read and wrote in its batch; call with
+    // queue_mutex held
+    void _finish_batch_task(const Ref<ConversionTask> &task, bool processed, int64_t bytes_in, int64_t bytes_out);
+    // Texture cache of a task's batch, or null for tasks queued on their own
+    std::shared_ptr<SharedTextureCache> _get_shared_textures(const Ref<ConversionTask> &task);
+    void _process_task(Ref<ConversionTask> task, EncoderLease &lease, bool up_to_date);
+    bool _is_up_to_date(const Ref<ConversionTask> &task);
+
+    // Cache key for a task's source bytes and options, or "" when caching is off
+    std::string _get_cache_key(const Ref<ConversionTask> &task, const uint8_t *source, size_t source_size);
+    // Complete a task from the cache if its output is there
+    bool _complete_from_cache(const Ref<ConversionTask> &task, const std::string &cache_key, const char *output_path);
     void _emit_started(int task_id, const String &source_path);
-    void _emit_progress(int task_id, const String &source_path, float progress);
-    void _emit_completed(int task_id, const String &source_path, const String &output_path, Error error, const String &error_message);
-    void _emit_batch_completed(const Array &results);
+    void _emit_completed(int task_id, const String &source_path, const String &output_path, Error error, const String &error_message, float progress);
+    void _emit_batch_progress(int batch_id, int done, int total, int64_t bytes_in, int64_t bytes_out, float eta);
+
+    // Publish a task's current progress; signals are coalesced by _pump_progress()
+    void _report_progress(const Ref<ConversionTask> &task);
+    void _pump_progress();
+    void _on_process_frame();
+    static float _estimate_batch_eta(const Batch &batch, int64_t now_usec);
+    void _emit_batch_completed(int batch_id, const Array &results);
 
     // Conversion implementations
-    void _convert_image_to_ktx2(Ref<ConversionTask> task);
-    void _convert_audio_to_mp3(Ref<ConversionTask> task);
-    void _convert_glb_textures_to_ktx2(Ref<ConversionTask> task);
-    void _normalize_audio(Ref<ConversionTask> task);
+    void _convert_image_to_ktx2(Ref<ConversionTask> task, EncoderLease &lease);
+    void _convert_audio_to_mp3(Ref<ConversionTask> task, EncoderLease &lease);
+    void _convert_audio_to_mp3_segmented(Ref<ConversionTask> task, basisu::job_pool *job_pool,
+            Mp3SegmentEncoder::Settings settings, int segment_count, int frame_samples, int encoder_delay);
+    void _convert_glb_textures_to_ktx2(Ref<ConversionTask> task, EncoderLease &lease);
+    void _normalize_audio(Ref<ConversionTask> task, EncoderLease &lease);
 
 protected:
     static void _bind_methods();
@@ -63,21 +150,64 @@ public:
     ~AssetConverter() override;
 
     // Conversion methods (all async)
-    int image_to_ktx2(const String &source_path, const String &output_path, int quality = 128, bool mipmaps = true);
-    int audio_to_mp3(const String &source_path, const String &output_path, int bitrate = 192);
-    int glb_textures_to_ktx2(const String &source_path, const String &output_path = "", int quality = 128, bool mipmaps = true);
-    int normalize_audio(const String &source_path, const String &output_path, float target_db = -14.0f, float peak_limit_db = -1.0f);
-
-    // Batch conversion
-    void convert_batch(const TypedArray<ConversionTask> &tasks);
+    int image_to_ktx2(const String &source_path, const String &output_path, int quality = 128, bool mipmaps = true,
+            ConversionTask::Encoder encoder = ConversionTask::ENCODER_UASTC, int compression_level = 2,
+            int max_size = 0, float scale = 1.0f, bool pow2 = false, ConversionTask::Priority priority = ConversionTask::PRIORITY_NORMAL);
+    int images_to_ktx2(const PackedStringArray &source_paths, const String &output_path,
+            ConversionTask::TextureLayout layout = ConversionTask::LAYOUT_2D_ARRAY, int quality = 128, bool mipmaps = true,
+            ConversionTask::Encoder encoder = ConversionTask::ENCODER_UASTC, int compression_level = 2,
+            int max_size = 0, float scale = 1.0f, bool pow2 = false, ConversionTask::Priority priority = ConversionTask::PRIORITY_NORMAL);
+    int audio_to_mp3(const String &source_path, const String &output_path, int bitrate = 192, bool parallel_segments = false,
+            ConversionTask::Priority priority = ConversionTask::PRIORITY_NORMAL);
+    int glb_textures_to_ktx2(const String &source_path, const String &output_path = "", int quality = 128, bool mipmaps = true,
+            bool keep_fallback = false, ConversionTask::Encoder encoder = ConversionTask::ENCODER_UASTC, int compression_level = 2,
+            int max_size = 0, float scale = 1.0f, bool pow2 = false, ConversionTask::Priority priority = ConversionTask::PRIORITY_NORMAL);
+    int normalize_audio(const String &source_path, const String &output_path, float target_db = -14.0f, float peak_limit_db = -1.0f,
+            ConversionTask::Priority priority = ConversionTask::PRIORITY_NORMAL);
+
+    // Batch conversion; returns the batch ID reported by batch_completed
+    int convert_batch(const TypedArray<ConversionTask> &tasks);
 
     // Control methods
     bool cancel(int task_id);
     void cancel_all();
     bool is_running() const;
     int get_pending_count() const;
+
+    // Queue wait per priority lane: {priority: {tasks, average_wait, max_wait}}, in seconds
+    Dictionary get_queue_wait_stats() const;
+    void reset_queue_wait_stats();
+
+    // Worker pool configuration (0 = one worker per CPU core)
+    void set_worker_count(int p_count);
+    int get_worker_count() const;
+
+    // Process-wide cap on encoder threads, shared by all converters (0 = CPU count)
+    static void set_max_threads(int p_count);
+    static int get_max_threads();
+
+    // Batch ordering by estimated cost (see ConversionTask.estimated_cost)
+    void set_scheduling_policy(SchedulingPolicy p_policy);
+    SchedulingPolicy get_scheduling_policy() const;
+
+    // Conversion cache for image and GLB outputs ("" disables it)
+    void set_cache_directory(const String &p_path);
+    String get_cache_directory();
+    void set_cache_max_size(int64_t p_bytes);
+    int64_t get_cache_max_size();
+    int64_t get_cache_hit_count() const;
+    int64_t get_cache_miss_count() const;
+
+    // GLB images reused from another GLB of the same batch
+    int64_t get_shared_texture_reuse_count() const;
+
+    // Skip tasks whose source, options and output are unchanged since the last run
+    void set_incremental(bool p_enabled);
+    bool is_incremental() const;
 };
 
 } // namespace godot
 
+VARIANT_ENUM_CAST(AssetConverter::SchedulingPolicy);
+
 #endif // ASSET_CONVERTER_H
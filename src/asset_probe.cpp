@@ -1,4 +1,5 @@
 #include "asset_probe.h"
+#include "mapped_file.h"
 
 #include <godot_cpp/classes/file_access.hpp>
 #include <godot_cpp/variant/packed_string_array.hpp>
@@ -74,10 +75,17 @@ Dictionary AssetProbe::probe_glb(const String &file_path) {
     CharString path_utf8 = file_path.utf8();
     const char *path_cstr = path_utf8.get_data();
 
+    // Map the file and parse it in place; the mapping must outlive data
+    MappedFile gltf_file;
+    if (!gltf_file.open(path_cstr)) {
+        result["error"] = "Failed to open file: " + file_path;
+        return result;
+    }
+
     // Parse GLB/GLTF
     cgltf_options options = {};
     cgltf_data *data = nullptr;
-    cgltf_result parse_result = cgltf_parse_file(&options, path_cstr, &data);
+    cgltf_result parse_result = cgltf_parse(&options, gltf_file.data(), gltf_file.size(), &data);
 
     if (parse_result != cgltf_result_success) {
         result["error"] = "Failed to parse GLB/GLTF file";
@@ -240,9 +248,15 @@ Dictionary AssetProbe::probe_glb(const String &file_path) {
         Dictionary tex_info;
         tex_info["name"] = tex->name ? String(tex->name) : String("texture_") + String::num_int64(i);
 
-        if (tex->image) {
-            tex_info["uri"] = tex->image->uri ? String(tex->image->uri) : String("");
-            tex_info["mime_type"] = tex->image->mime_type ? String(tex->image->mime_type) : String("");
+        // KHR_texture_basisu takes precedence over the core source, which is then only a fallback
+        cgltf_image *image = (tex->has_basisu && tex->basisu_image) ? tex->basisu_image : tex->image;
+        if (image) {
+            tex_info["uri"] = image->uri ? String(image->uri) : String("");
+            tex_info["mime_type"] = image->mime_type ? String(image->mime_type) : String("");
+        }
+        tex_info["has_basisu"] = (bool)tex->has_basisu;
+        if (tex->has_basisu && tex->image) {
+            tex_info["fallback_mime_type"] = tex->image->mime_type ? String(tex->image->mime_type) : String("");
         }
 
         textures_array.push_back(tex_info);
@@ -294,6 +308,8 @@ Dictionary AssetProbe::probe_ktx2(const String &file_path) {
     uint32_t face_count = file->get_32();
     uint32_t level_count = file->get_32();
     uint32_t supercompression_scheme = file->get_32();
+    uint32_t dfd_byte_offset = file->get_32();
+    uint32_t dfd_byte_length = file->get_32();
 
     result["width"] = (int64_t)pixel_width;
     result["height"] = (int64_t)pixel_height;
@@ -360,6 +376,22 @@ Dictionary AssetProbe::probe_ktx2(const String &file_path) {
                      format_str.contains("BC7") || format_str.contains("A1");
     result["has_alpha"] = has_alpha;
 
+    // Transfer function of the Basic Data Format Descriptor: the byte after the color
+    // model and primaries, behind the DFD size and the two block header words.
+    // Basis Universal formats are UNDEFINED, so this is where sRGB is recorded.
+    String transfer_function = "unknown";
+    if (dfd_byte_length >= 16) {
+        uint8_t transfer = 0;
+        file->seek(dfd_byte_offset + 14);
+        file->get_buffer(&transfer, 1);
+        if (transfer == 1) {
+            transfer_function = "linear";
+        } else if (transfer == 2) {
+            transfer_function = "srgb";
+        }
+    }
+    result["transfer_function"] = transfer_function;
+
     // Get file size
     result["size_bytes"] = (int64_t)file->get_length();
 
@@ -386,8 +418,10 @@ Dictionary AssetProbe::probe_audio(const String &file_path, bool analyze_volume)
     CharString path_utf8 = file_path.utf8();
     const char *path_cstr = path_utf8.get_data();
 
+    // Decode straight from the mapped file
+    MappedFile mp3_file;
     drmp3 mp3;
-    if (!drmp3_init_file(&mp3, path_cstr, nullptr)) {
+    if (!mp3_file.open(path_cstr) || !drmp3_init_memory(&mp3, mp3_file.data(), mp3_file.size(), nullptr)) {
         result["error"] = "Failed to open MP3 file";
         return result;
     }
@@ -415,8 +449,7 @@ Dictionary AssetProbe::probe_audio(const String &file_path, bool analyze_volume)
     }
 
     // Get file size
-    Ref<FileAccess> file = FileAccess::open(file_path, FileAccess::READ);
-    int64_t file_size = file.is_valid() ? file->get_length() : 0;
+    int64_t file_size = (int64_t)mp3_file.size();
 
     // Calculate bitrate
     int bitrate = 0;
@@ -0,0 +1,216 @@
+#include "batch_manifest.h"
+#include "conversion_cache.h"
+#include "mapped_file.h"
+#include "output_file.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/classes/time.hpp>
+
+using namespace godot;
+
+const char *BatchManifest::FILE_NAME = ".gd_asset_op_manifest";
+
+// First line of every manifest; bump the number when the line format changes
+static const char *MANIFEST_HEADER = "gd-asset-op manifest 1";
+
+static bool stat_file(const String &path, uint64_t &r_size, int64_t &r_mtime) {
+    Ref<FileAccess> file = FileAccess::open(path, FileAccess::READ);
+    if (file.is_null()) {
+        return false;
+    }
+    r_size = file->get_length();
+    r_mtime = (int64_t)FileAccess::get_modified_time(path);
+    return true;
+}
+
+// A file written later in the same second would keep its time, so a time that is not
+// yet in the past is stored as unknown and the next check hashes the file
+static int64_t settled_mtime(int64_t mtime) {
+    return mtime < (int64_t)Time::get_singleton()->get_unix_time_from_system() ? mtime : -1;
+}
+
+static bool hash_file(const String &path, uint64_t &r_hash) {
+    // Mapping needs a native path
+    CharString native_utf8 = ProjectSettings::get_singleton()->globalize_path(path).utf8();
+    MappedFile file;
+    if (!file.open(native_utf8.get_data())) {
+        return false;
+    }
+    r_hash = ConversionCache::hash64(file.data(), file.size());
+    return true;
+}
+
+static std::string to_hex(uint64_t value) {
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)value);
+    return std::string(hex);
+}
+
+BatchManifest::Manifest &BatchManifest::_get_manifest(const String &directory) {
+    std::string key = directory.utf8().get_data();
+    auto it = manifests.find(key);
+    if (it != manifests.end()) {
+        return it->second;
+    }
+
+    Manifest &manifest = manifests[key];
+
+    PackedByteArray bytes = FileAccess::get_file_as_bytes(directory.path_join(FILE_NAME));
+    std::stringstream file(std::string(reinterpret_cast<const char *>(bytes.ptr()), bytes.size()));
+    std::string line;
+    if (bytes.is_empty() || !std::getline(file, line) || line != MANIFEST_HEADER) {
+        return manifest; // Missing, unreadable or from another format version
+    }
+
+    // output \t type \t source size \t source mtime \t source hash \t
+    // output size \t output mtime \t output hash \t source path \t options
+    while (std::getline(file, line)) {
+        std::vector<std::string> fields;
+        std::stringstream stream(line);
+        std::string field;
+        while (std::getline(stream, field, '\t')) {
+            fields.push_back(field);
+        }
+        if (fields.size() != 10) {
+            continue;
+        }
+
+        Entry entry;
+        entry.type = atoi(fields[1].c_str());
+        entry.source_size = strtoull(fields[2].c_str(), nullptr, 10);
+        entry.source_mtime = strtoll(fields[3].c_str(), nullptr, 10);
+        entry.source_hash = strtoull(fields[4].c_str(), nullptr, 16);
+        entry.output_size = strtoull(fields[5].c_str(), nullptr, 10);
+        entry.output_mtime = strtoll(fields[6].c_str(), nullptr, 10);
+        entry.output_hash = strtoull(fields[7].c_str(), nullptr, 16);
+        entry.source_path = fields[8];
+        entry.options = fields[9];
+        manifest.entries[fields[0]] = entry;
+    }
+    return manifest;
+}
+
+bool BatchManifest::is_up_to_date(int type, const std::string &source_path, const std::string &output_path, const std::string &options) {
+    String source = String::utf8(source_path.c_str());
+    String output = String::utf8(output_path.c_str());
+    std::string output_name = output.get_file().utf8().get_data();
+
+    Entry entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Manifest &manifest = _get_manifest(output.get_base_dir());
+        auto it = manifest.entries.find(output_name);
+        if (it == manifest.entries.end()) {
+            return false;
+        }
+        entry = it->second;
+    }
+
+    if (entry.type != type || entry.source_path != source_path || entry.options != options) {
+        return false;
+    }
+
+    uint64_t source_size, output_size;
+    int64_t source_mtime, output_mtime;
+    if (!stat_file(source, source_size, source_mtime) || !stat_file(output, output_size, output_mtime)) {
+        return false;
+    }
+    if (source_size != entry.source_size || output_size != entry.output_size) {
+        return false;
+    }
+
+    // A changed time alone does not mean changed content; compare hashes
+    bool touched = false;
+    if (source_mtime != entry.source_mtime) {
+        uint64_t hash;
+        if (!hash_file(source, hash) || hash != entry.source_hash) {
+            return false;
+        }
+        touched = true;
+    }
+    if (output_mtime != entry.output_mtime) {
+        uint64_t hash;
+        if (!hash_file(output, hash) || hash != entry.output_hash) {
+            return false;
+        }
+        touched = true;
+    }
+
+    // Remember the new times so the next check is stat-only again
+    if (touched) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Manifest &manifest = _get_manifest(output.get_base_dir());
+        auto it = manifest.entries.find(output_name);
+        if (it != manifest.entries.end()) {
+            it->second.source_mtime = settled_mtime(source_mtime);
+            it->second.output_mtime = settled_mtime(output_mtime);
+            manifest.dirty = true;
+        }
+    }
+    return true;
+}
+
+void BatchManifest::record(int type, const std::string &source_path, const std::string &output_path, const std::string &options) {
+    // Fields are tab separated and entries newline separated
+    if (source_path.find_first_of("\t\n") != std::string::npos || output_path.find_first_of("\t\n") != std::string::npos ||
+            options.find_first_of("\t\n") != std::string::npos) {
+        return;
+    }
+
+    String source = String::utf8(source_path.c_str());
+    String output = String::utf8(output_path.c_str());
+
+    Entry entry;
+    entry.type = type;
+    entry.source_path = source_path;
+    entry.options = options;
+    if (!stat_file(source, entry.source_size, entry.source_mtime) || !hash_file(source, entry.source_hash) ||
+            !stat_file(output, entry.output_size, entry.output_mtime) || !hash_file(output, entry.output_hash)) {
+        return;
+    }
+    entry.source_mtime = settled_mtime(entry.source_mtime);
+    entry.output_mtime = settled_mtime(entry.output_mtime);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Manifest &manifest = _get_manifest(output.get_base_dir());
+    manifest.entries[output.get_file().utf8().get_data()] = entry;
+    manifest.dirty = true;
+}
+
+void BatchManifest::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (const auto &item : manifests) {
+        const Manifest &manifest = item.second;
+        if (!manifest.dirty) {
+            continue;
+        }
+
+        // The atomic writer needs a native path
+        String path = String::utf8(item.first.c_str()).path_join(FILE_NAME);
+        CharString native_utf8 = ProjectSettings::get_singleton()->globalize_path(path).utf8();
+        OutputFile file(native_utf8.get_data());
+        if (!file.open()) {
+            continue;
+        }
+        std::ofstream &out = file.stream();
+        out << MANIFEST_HEADER << '\n';
+        for (const auto &output : manifest.entries) {
+            const Entry &entry = output.second;
+            out << output.first << '\t' << entry.type << '\t'
+                << entry.source_size << '\t' << entry.source_mtime << '\t' << to_hex(entry.source_hash) << '\t'
+                << entry.output_size << '\t' << entry.output_mtime << '\t' << to_hex(entry.output_hash) << '\t'
+                << entry.source_path << '\t' << entry.options << '\n';
+        }
+        file.commit();
+    }
+
+    manifests.clear();
+}
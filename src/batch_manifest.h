@@ -0,0 +1,61 @@
+#ifndef BATCH_MANIFEST_H
+#define BATCH_MANIFEST_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <godot_cpp/variant/string.hpp>
+
+namespace godot {
+
+// Record of finished conversions for incremental batches.
+// Each output directory keeps a manifest file (FILE_NAME) with one entry per output:
+// the source path, size, modification time and content hash, the conversion type and
+// options, and the output size, modification time and content hash. A task is up to
+// date when its entry matches. Sizes and times are compared first, so an unchanged
+// tree is checked with two stats per task; content is hashed only when a time
+// differs, which keeps touched-but-identical files from being reconverted. Times have
+// one-second resolution, so a time within the second an entry was recorded is not
+// trusted and the file is hashed on the next check.
+class BatchManifest {
+private:
+    struct Entry {
+        int type;
+        std::string source_path;
+        uint64_t source_size;
+        int64_t source_mtime;
+        uint64_t source_hash;
+        std::string options;
+        uint64_t output_size;
+        int64_t output_mtime;
+        uint64_t output_hash;
+    };
+
+    struct Manifest {
+        std::unordered_map<std::string, Entry> entries; // Keyed by output file name
+        bool dirty = false;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<std::string, Manifest> manifests; // Keyed by output directory
+
+    // Caller holds the mutex. Loads the directory's manifest on first use.
+    Manifest &_get_manifest(const String &directory);
+
+public:
+    static const char *FILE_NAME;
+
+    // Paths are UTF-8
+    bool is_up_to_date(int type, const std::string &source_path, const std::string &output_path, const std::string &options);
+    // Add or replace the entry for a finished conversion
+    void record(int type, const std::string &source_path, const std::string &output_path, const std::string &options);
+
+    // Write changed manifests and forget all loaded ones
+    void flush();
+};
+
+} // namespace godot
+
+#endif // BATCH_MANIFEST_H
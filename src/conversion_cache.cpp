@@ -0,0 +1,284 @@
+#include "conversion_cache.h"
+#include "output_file.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+
+// Basis Universal version, part of every key so an encoder upgrade invalidates the cache
+#include "basisu_comp.h"
+
+using namespace godot;
+
+// Bump when converter output changes for the same source and options
+static const uint32_t CACHE_FORMAT_VERSION = 1;
+
+// Default size cap: 1 GiB
+static const uint64_t DEFAULT_MAX_SIZE = 1ull << 30;
+
+// ============================================================
+// XXH64 (https://github.com/Cyan4973/xxHash, reference algorithm)
+// ============================================================
+
+static const uint64_t XXH_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t XXH_PRIME64_3 = 0x165667B19E3779F9ULL;
+static const uint64_t XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t XXH_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+static inline uint64_t xxh_rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t xxh_read64(const uint8_t *p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value; // Little-endian hosts only, like the GLB code
+}
+
+static inline uint32_t xxh_read32(const uint8_t *p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint64_t xxh_round(uint64_t acc, uint64_t input) {
+    acc += input * XXH_PRIME64_2;
+    acc = xxh_rotl64(acc, 31);
+    return acc * XXH_PRIME64_1;
+}
+
+static inline uint64_t xxh_merge_round(uint64_t acc, uint64_t val) {
+    acc ^= xxh_round(0, val);
+    return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+uint64_t ConversionCache::hash64(const void *data, size_t size, uint64_t seed) {
+    const uint8_t *p = (const uint8_t *)data;
+    const uint8_t *end = p + size;
+    uint64_t h64;
+
+    if (size >= 32) {
+        const uint8_t *limit = end - 32;
+        uint64_t v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+        uint64_t v2 = seed + XXH_PRIME64_2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - XXH_PRIME64_1;
+
+        do {
+            v1 = xxh_round(v1, xxh_read64(p));
+            v2 = xxh_round(v2, xxh_read64(p + 8));
+            v3 = xxh_round(v3, xxh_read64(p + 16));
+            v4 = xxh_round(v4, xxh_read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        h64 = xxh_rotl64(v1, 1) + xxh_rotl64(v2, 7) + xxh_rotl64(v3, 12) + xxh_rotl64(v4, 18);
+        h64 = xxh_merge_round(h64, v1);
+        h64 = xxh_merge_round(h64, v2);
+        h64 = xxh_merge_round(h64, v3);
+        h64 = xxh_merge_round(h64, v4);
+    } else {
+        h64 = seed + XXH_PRIME64_5;
+    }
+
+    h64 += (uint64_t)size;
+
+    while (p + 8 <= end) {
+        h64 ^= xxh_round(0, xxh_read64(p));
+        h64 = xxh_rotl64(h64, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+        p += 8;
+    }
+    if (p + 4 <= end) {
+        h64 ^= (uint64_t)xxh_read32(p) * XXH_PRIME64_1;
+        h64 = xxh_rotl64(h64, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+        p += 4;
+    }
+    while (p < end) {
+        h64 ^= (*p) * XXH_PRIME64_5;
+        h64 = xxh_rotl64(h64, 11) * XXH_PRIME64_1;
+        p++;
+    }
+
+    h64 ^= h64 >> 33;
+    h64 *= XXH_PRIME64_2;
+    h64 ^= h64 >> 29;
+    h64 *= XXH_PRIME64_3;
+    h64 ^= h64 >> 32;
+    return h64;
+}
+
+// ============================================================
+// Cache
+// ============================================================
+
+ConversionCache::ConversionCache() :
+        max_size(DEFAULT_MAX_SIZE),
+        total_size(0),
+        next_use(0),
+        hit_count(0),
+        miss_count(0) {
+}
+
+void ConversionCache::set_directory(const std::string &p_directory) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    total_size = 0;
+    directory = String::utf8(p_directory.c_str());
+    if (!directory.is_empty()) {
+        _load_index();
+        _evict();
+    }
+}
+
+std::string ConversionCache::get_directory() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::string(directory.utf8().get_data());
+}
+
+bool ConversionCache::is_enabled() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !directory.is_empty();
+}
+
+void ConversionCache::set_max_size(uint64_t p_bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    max_size = p_bytes;
+    _evict();
+}
+
+uint64_t ConversionCache::get_max_size() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return max_size;
+}
+
+void ConversionCache::_load_index() {
+    DirAccess::make_dir_recursive_absolute(directory);
+
+    PackedStringArray files = DirAccess::get_files_at(directory);
+    for (int i = 0; i < files.size(); i++) {
+        std::string name = files[i].utf8().get_data();
+        if (name.size() != 16 || name.find_first_not_of("0123456789abcdef") != std::string::npos) {
+            continue; // Temporary files and foreign files
+        }
+
+        String path = directory.path_join(files[i]);
+        Ref<FileAccess> file = FileAccess::open(path, FileAccess::READ);
+        if (file.is_null()) {
+            continue;
+        }
+        Entry entry;
+        entry.size = file->get_length();
+        entry.last_used = FileAccess::get_modified_time(path);
+        entries[name] = entry;
+        total_size += entry.size;
+        next_use = MAX(next_use, entry.last_used + 1);
+    }
+}
+
+void ConversionCache::_evict() {
+    if (directory.is_empty() || total_size <= max_size) {
+        return;
+    }
+
+    std::vector<std::pair<uint64_t, std::string>> by_age;
+    by_age.reserve(entries.size());
+    for (const auto &entry : entries) {
+        by_age.emplace_back(entry.second.last_used, entry.first);
+    }
+    std::sort(by_age.begin(), by_age.end());
+
+    for (const auto &item : by_age) {
+        if (total_size <= max_size) {
+            break;
+        }
+        DirAccess::remove_absolute(directory.path_join(String::utf8(item.second.c_str())));
+        total_size -= entries[item.second].size;
+        entries.erase(item.second);
+    }
+}
+
+std::string ConversionCache::make_key(int type, const uint8_t *source, size_t source_size, const std::string &options) {
+    uint64_t source_hash = hash64(source, source_size);
+
+    // Fold conversion type, options and versions into the source hash
+    std::string salt = std::to_string(type) + "|" + options + "|basisu " + std::to_string(BASISU_LIB_VERSION) +
+            "|format " + std::to_string(CACHE_FORMAT_VERSION);
+    uint64_t key = hash64(salt.data(), salt.size(), source_hash);
+
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)key);
+    return std::string(hex);
+}
+
+bool ConversionCache::fetch(const std::string &key, const char *output_path) {
+    String entry_path;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        if (directory.is_empty() || it == entries.end()) {
+            miss_count++;
+            return false;
+        }
+        entry_path = directory.path_join(String::utf8(key.c_str()));
+
+        // Refresh recency
+        it->second.last_used = next_use++;
+    }
+
+    // Copy through a temporary file so a failed copy never leaves a partial output
+    OutputFile outfile(output_path);
+    Error err = DirAccess::copy_absolute(entry_path, String::utf8(outfile.get_temp_path()));
+    if (err != OK || !outfile.commit()) {
+        // Entry vanished (e.g. evicted by another converter sharing the directory)
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            total_size -= it->second.size;
+            entries.erase(it);
+        }
+        miss_count++;
+        return false;
+    }
+
+    hit_count++;
+    return true;
+}
+
+void ConversionCache::store(const std::string &key, const char *output_path) {
+    String entry_path;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (directory.is_empty() || entries.count(key)) {
+            return;
+        }
+        entry_path = directory.path_join(String::utf8(key.c_str()));
+    }
+
+    CharString entry_utf8 = entry_path.utf8();
+    OutputFile entry_file(entry_utf8.get_data());
+    if (DirAccess::copy_absolute(String::utf8(output_path), String::utf8(entry_file.get_temp_path())) != OK ||
+            !entry_file.commit()) {
+        return;
+    }
+
+    Ref<FileAccess> file = FileAccess::open(entry_path, FileAccess::READ);
+    if (file.is_null()) {
+        return;
+    }
+    Entry entry;
+    entry.size = file->get_length();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (entries.count(key)) {
+        return;
+    }
+    entry.last_used = next_use++;
+    entries[key] = entry;
+    total_size += entry.size;
+    _evict();
+}
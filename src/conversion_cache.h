@@ -0,0 +1,69 @@
+#ifndef CONVERSION_CACHE_H
+#define CONVERSION_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <godot_cpp/variant/string.hpp>
+
+namespace godot {
+
+// Content-addressed on-disk cache of conversion outputs.
+// Entries are keyed by an XXH64 of the source bytes, the conversion type, the options
+// and the encoder version, and stored as one file per key in the cache directory.
+// A hit copies the entry to the output path. The total size is capped; the least
+// recently used entries are evicted first. Recency is tracked in memory from each
+// entry's modification time when the directory is loaded, then from every hit.
+class ConversionCache {
+private:
+    struct Entry {
+        uint64_t size;
+        uint64_t last_used; // Use sequence number, ordered after the loaded modification times
+    };
+
+    std::mutex mutex;
+    String directory; // Empty when the cache is disabled
+    uint64_t max_size;
+    std::unordered_map<std::string, Entry> entries;
+    uint64_t total_size;
+    uint64_t next_use;
+
+    std::atomic<uint64_t> hit_count;
+    std::atomic<uint64_t> miss_count;
+
+    // Caller holds the mutex
+    void _load_index();
+    void _evict();
+
+public:
+    ConversionCache();
+
+    // Path is UTF-8; an empty path disables the cache
+    void set_directory(const std::string &p_directory);
+    std::string get_directory();
+    bool is_enabled();
+
+    void set_max_size(uint64_t p_bytes);
+    uint64_t get_max_size();
+
+    // Key for a conversion of the given source bytes
+    static std::string make_key(int type, const uint8_t *source, size_t source_size, const std::string &options);
+
+    // Copy a cached output to output_path. Counts a hit or a miss.
+    bool fetch(const std::string &key, const char *output_path);
+    // Add a finished output to the cache, evicting old entries over the size cap
+    void store(const std::string &key, const char *output_path);
+
+    uint64_t get_hit_count() const { return hit_count.load(); }
+    uint64_t get_miss_count() const { return miss_count.load(); }
+
+    static uint64_t hash64(const void *data, size_t size, uint64_t seed = 0);
+};
+
+} // namespace godot
+
+#endif // CONVERSION_CACHE_H
@@ -8,6 +8,7 @@ void ConversionTask::_bind_methods() {
     BIND_ENUM_CONSTANT(AUDIO_TO_MP3);
     BIND_ENUM_CONSTANT(GLB_TEXTURES_TO_KTX2);
     BIND_ENUM_CONSTANT(NORMALIZE_AUDIO);
+    BIND_ENUM_CONSTANT(IMAGES_TO_KTX2);
 
     BIND_ENUM_CONSTANT(PENDING);
     BIND_ENUM_CONSTANT(RUNNING);
@@ -15,8 +16,22 @@ void ConversionTask::_bind_methods() {
     BIND_ENUM_CONSTANT(FAILED);
     BIND_ENUM_CONSTANT(CANCELLED);
 
+    BIND_ENUM_CONSTANT(ENCODER_UASTC);
+    BIND_ENUM_CONSTANT(ENCODER_ETC1S);
+    BIND_ENUM_CONSTANT(ENCODER_UASTC_HDR_4X4);
+    BIND_ENUM_CONSTANT(ENCODER_ASTC_HDR_6X6);
+
+    BIND_ENUM_CONSTANT(LAYOUT_2D_ARRAY);
+    BIND_ENUM_CONSTANT(LAYOUT_CUBEMAP);
+    BIND_ENUM_CONSTANT(LAYOUT_VOLUME);
+
+    BIND_ENUM_CONSTANT(PRIORITY_INTERACTIVE);
+    BIND_ENUM_CONSTANT(PRIORITY_NORMAL);
+    BIND_ENUM_CONSTANT(PRIORITY_BACKGROUND);
+
     // Properties
     ClassDB::bind_method(D_METHOD("get_id"), &ConversionTask::get_id);
+    ClassDB::bind_method(D_METHOD("get_batch_id"), &ConversionTask::get_batch_id);
     ClassDB::bind_method(D_METHOD("get_type"), &ConversionTask::get_type);
     ClassDB::bind_method(D_METHOD("get_status"), &ConversionTask::get_status);
     ClassDB::bind_method(D_METHOD("get_source_path"), &ConversionTask::get_source_path);
@@ -25,9 +40,14 @@ void ConversionTask::_bind_methods() {
     ClassDB::bind_method(D_METHOD("get_progress"), &ConversionTask::get_progress);
     ClassDB::bind_method(D_METHOD("get_error"), &ConversionTask::get_error);
     ClassDB::bind_method(D_METHOD("get_error_message"), &ConversionTask::get_error_message);
+    ClassDB::bind_method(D_METHOD("get_estimated_cost"), &ConversionTask::get_estimated_cost);
+    ClassDB::bind_method(D_METHOD("get_priority"), &ConversionTask::get_priority);
+    ClassDB::bind_method(D_METHOD("set_priority", "priority"), &ConversionTask::set_priority);
+    ClassDB::bind_method(D_METHOD("get_segment_count"), &ConversionTask::get_segment_count);
 
     ADD_PROPERTY(PropertyInfo(Variant::INT, "id"), "", "get_id");
-    ADD_PROPERTY(PropertyInfo(Variant::INT, "type", PROPERTY_HINT_ENUM, "IMAGE_TO_KTX2,AUDIO_TO_MP3,GLB_TEXTURES_TO_KTX2,NORMALIZE_AUDIO"), "", "get_type");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "batch_id"), "", "get_batch_id");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "type", PROPERTY_HINT_ENUM, "IMAGE_TO_KTX2,AUDIO_TO_MP3,GLB_TEXTURES_TO_KTX2,NORMALIZE_AUDIO,IMAGES_TO_KTX2"), "", "get_type");
     ADD_PROPERTY(PropertyInfo(Variant::INT, "status", PROPERTY_HINT_ENUM, "PENDING,RUNNING,COMPLETED,FAILED,CANCELLED"), "", "get_status");
     ADD_PROPERTY(PropertyInfo(Variant::STRING, "source_path"), "", "get_source_path");
     ADD_PROPERTY(PropertyInfo(Variant::STRING, "output_path"), "", "get_output_path");
@@ -35,48 +55,77 @@ void ConversionTask::_bind_methods() {
     ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "progress"), "", "get_progress");
     ADD_PROPERTY(PropertyInfo(Variant::INT, "error"), "", "get_error");
     ADD_PROPERTY(PropertyInfo(Variant::STRING, "error_message"), "", "get_error_message");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "estimated_cost"), "", "get_estimated_cost");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "priority", PROPERTY_HINT_ENUM, "INTERACTIVE,NORMAL,BACKGROUND"), "set_priority", "get_priority");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "segment_count"), "", "get_segment_count");
 
     // Factory methods
-    ClassDB::bind_static_method("ConversionTask", D_METHOD("create_image_to_ktx2", "source", "output", "quality", "mipmaps"), &ConversionTask::create_image_to_ktx2, DEFVAL(128), DEFVAL(true));
-    ClassDB::bind_static_method("ConversionTask", D_METHOD("create_audio_to_mp3", "source", "output", "bitrate"), &ConversionTask::create_audio_to_mp3, DEFVAL(192));
-    ClassDB::bind_static_method("ConversionTask", D_METHOD("create_glb_textures_to_ktx2", "source", "output", "quality", "mipmaps"), &ConversionTask::create_glb_textures_to_ktx2, DEFVAL(128), DEFVAL(true));
+    ClassDB::bind_static_method("ConversionTask", D_METHOD("create_image_to_ktx2", "source", "output", "quality", "mipmaps", "encoder", "compression_level", "max_size", "scale", "pow2"), &ConversionTask::create_image_to_ktx2, DEFVAL(128), DEFVAL(true), DEFVAL(ENCODER_UASTC), DEFVAL(2), DEFVAL(0), DEFVAL(1.0f), DEFVAL(false));
+    ClassDB::bind_static_method("ConversionTask", D_METHOD("create_images_to_ktx2", "sources", "output", "layout", "quality", "mipmaps", "encoder", "compression_level", "max_size", "scale", "pow2"), &ConversionTask::create_images_to_ktx2, DEFVAL(LAYOUT_2D_ARRAY), DEFVAL(128), DEFVAL(true), DEFVAL(ENCODER_UASTC), DEFVAL(2), DEFVAL(0), DEFVAL(1.0f), DEFVAL(false));
+    ClassDB::bind_static_method("ConversionTask", D_METHOD("create_audio_to_mp3", "source", "output", "bitrate", "parallel_segments"), &ConversionTask::create_audio_to_mp3, DEFVAL(192), DEFVAL(false));
+    ClassDB::bind_static_method("ConversionTask", D_METHOD("create_glb_textures_to_ktx2", "source", "output", "quality", "mipmaps", "keep_fallback", "encoder", "compression_level", "max_size", "scale", "pow2"), &ConversionTask::create_glb_textures_to_ktx2, DEFVAL(128), DEFVAL(true), DEFVAL(false), DEFVAL(ENCODER_UASTC), DEFVAL(2), DEFVAL(0), DEFVAL(1.0f), DEFVAL(false));
     ClassDB::bind_static_method("ConversionTask", D_METHOD("create_normalize_audio", "source", "output", "target_db", "peak_limit_db"), &ConversionTask::create_normalize_audio, DEFVAL(-14.0f), DEFVAL(-1.0f));
 }
 
 ConversionTask::ConversionTask() {
     id = -1;
+    batch_id = -1;
     type = IMAGE_TO_KTX2;
     status = PENDING;
     progress = 0.0f;
     error = OK;
+    estimated_cost = -1.0f;
+    priority = PRIORITY_NORMAL;
+    queued_usec = 0;
+    segment_count = 0;
+    cancel_requested = false;
 }
 
 ConversionTask::~ConversionTask() = default;
 
 // Getters
 int ConversionTask::get_id() const { return id; }
+int ConversionTask::get_batch_id() const { return batch_id; }
 ConversionTask::Type ConversionTask::get_type() const { return type; }
-ConversionTask::Status ConversionTask::get_status() const { return status; }
+ConversionTask::Status ConversionTask::get_status() const { return status.load(); }
 String ConversionTask::get_source_path() const { return source_path; }
 String ConversionTask::get_output_path() const { return output_path; }
 Dictionary ConversionTask::get_options() const { return options; }
 float ConversionTask::get_progress() const { return progress; }
 Error ConversionTask::get_error() const { return error; }
 String ConversionTask::get_error_message() const { return error_message; }
+float ConversionTask::get_estimated_cost() const { return estimated_cost; }
+ConversionTask::Priority ConversionTask::get_priority() const { return priority; }
+int64_t ConversionTask::get_queued_usec() const { return queued_usec; }
+int ConversionTask::get_segment_count() const { return segment_count; }
 
 // Setters
 void ConversionTask::set_id(int p_id) { id = p_id; }
+void ConversionTask::set_batch_id(int p_batch_id) { batch_id = p_batch_id; }
 void ConversionTask::set_type(Type p_type) { type = p_type; }
-void ConversionTask::set_status(Status p_status) { status = p_status; }
+void ConversionTask::set_status(Status p_status) { status.store(p_status); }
 void ConversionTask::set_source_path(const String &p_path) { source_path = p_path; }
 void ConversionTask::set_output_path(const String &p_path) { output_path = p_path; }
 void ConversionTask::set_options(const Dictionary &p_options) { options = p_options; }
 void ConversionTask::set_progress(float p_progress) { progress = p_progress; }
 void ConversionTask::set_error(Error p_error) { error = p_error; }
 void ConversionTask::set_error_message(const String &p_message) { error_message = p_message; }
+void ConversionTask::set_estimated_cost(float p_cost) { estimated_cost = p_cost; }
+void ConversionTask::set_priority(Priority p_priority) { priority = p_priority; }
+void ConversionTask::set_queued_usec(int64_t p_usec) { queued_usec = p_usec; }
+void ConversionTask::set_segment_count(int p_count) { segment_count = p_count; }
+
+bool ConversionTask::try_set_status(Status p_from, Status p_to) {
+    return status.compare_exchange_strong(p_from, p_to);
+}
+
+void ConversionTask::request_cancel() { cancel_requested.store(true, std::memory_order_release); }
+bool ConversionTask::is_cancel_requested() const { return cancel_requested.load(std::memory_order_acquire); }
+const std::atomic<bool> *ConversionTask::get_cancel_token() const { return &cancel_requested; }
 
 // Factory methods
-Ref<ConversionTask> ConversionTask::create_image_to_ktx2(const String &source, const String &output, int quality, bool mipmaps) {
+Ref<ConversionTask> ConversionTask::create_image_to_ktx2(const String &source, const String &output, int quality, bool mipmaps,
+        Encoder encoder, int compression_level, int max_size, float scale, bool pow2) {
     Ref<ConversionTask> task;
     task.instantiate();
     task->set_type(IMAGE_TO_KTX2);
@@ -86,12 +135,40 @@ Ref<ConversionTask> ConversionTask::create_image_to_ktx2(const String &source, c
     Dictionary opts;
     opts["quality"] = quality;
     opts["mipmaps"] = mipmaps;
+    opts["encoder"] = encoder;
+    opts["compression_level"] = compression_level;
+    opts["max_size"] = max_size;
+    opts["scale"] = scale;
+    opts["pow2"] = pow2;
+    task->set_options(opts);
+
+    return task;
+}
+
+Ref<ConversionTask> ConversionTask::create_images_to_ktx2(const PackedStringArray &sources, const String &output, TextureLayout layout,
+        int quality, bool mipmaps, Encoder encoder, int compression_level, int max_size, float scale, bool pow2) {
+    Ref<ConversionTask> task;
+    task.instantiate();
+    task->set_type(IMAGES_TO_KTX2);
+    task->set_source_path(sources.is_empty() ? String() : sources[0]);
+    task->set_output_path(output);
+
+    Dictionary opts;
+    opts["sources"] = sources;
+    opts["layout"] = layout;
+    opts["quality"] = quality;
+    opts["mipmaps"] = mipmaps;
+    opts["encoder"] = encoder;
+    opts["compression_level"] = compression_level;
+    opts["max_size"] = max_size;
+    opts["scale"] = scale;
+    opts["pow2"] = pow2;
     task->set_options(opts);
 
     return task;
 }
 
-Ref<ConversionTask> ConversionTask::create_audio_to_mp3(const String &source, const String &output, int bitrate) {
+Ref<ConversionTask> ConversionTask::create_audio_to_mp3(const String &source, const String &output, int bitrate, bool parallel_segments) {
     Ref<ConversionTask> task;
     task.instantiate();
     task->set_type(AUDIO_TO_MP3);
@@ -100,12 +177,14 @@ Ref<ConversionTask> ConversionTask::create_audio_to_mp3(const String &source, co
 
     Dictionary opts;
     opts["bitrate"] = bitrate;
+    opts["parallel_segments"] = parallel_segments;
     task->set_options(opts);
 
     return task;
 }
 
-Ref<ConversionTask> ConversionTask::create_glb_textures_to_ktx2(const String &source, const String &output, int quality, bool mipmaps) {
+Ref<ConversionTask> ConversionTask::create_glb_textures_to_ktx2(const String &source, const String &output, int quality, bool mipmaps,
+        bool keep_fallback, Encoder encoder, int compression_level, int max_size, float scale, bool pow2) {
     Ref<ConversionTask> task;
     task.instantiate();
     task->set_type(GLB_TEXTURES_TO_KTX2);
@@ -115,6 +194,12 @@ Ref<ConversionTask> ConversionTask::create_glb_textures_to_ktx2(const String &so
     Dictionary opts;
     opts["quality"] = quality;
     opts["mipmaps"] = mipmaps;
+    opts["keep_fallback"] = keep_fallback;
+    opts["encoder"] = encoder;
+    opts["compression_level"] = compression_level;
+    opts["max_size"] = max_size;
+    opts["scale"] = scale;
+    opts["pow2"] = pow2;
     task->set_options(opts);
 
     return task;
@@ -4,8 +4,11 @@
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
 #include <godot_cpp/variant/string.hpp>
 
+#include <atomic>
+
 namespace godot {
 
 class ConversionTask : public RefCounted {
@@ -16,7 +19,8 @@ public:
         IMAGE_TO_KTX2,
         AUDIO_TO_MP3,
         GLB_TEXTURES_TO_KTX2,
-        NORMALIZE_AUDIO
+        NORMALIZE_AUDIO,
+        IMAGES_TO_KTX2
     };
 
     enum Status {
@@ -27,16 +31,47 @@ public:
         CANCELLED
     };
 
+    // KTX2 texture encoder
+    enum Encoder {
+        ENCODER_UASTC,         // UASTC LDR 4x4 + Zstandard: high quality, larger files
+        ENCODER_ETC1S,         // ETC1S + BasisLZ: several times smaller, lower quality
+        ENCODER_UASTC_HDR_4X4, // UASTC HDR 4x4 + Zstandard: default for .hdr/.exr sources
+        ENCODER_ASTC_HDR_6X6   // ASTC HDR 6x6 + Zstandard: smaller HDR files, slower encode
+    };
+
+    // Queue lane. Workers take higher lanes first; waiting tasks age upwards (see TaskQueue).
+    enum Priority {
+        PRIORITY_INTERACTIVE, // Editor previews and other conversions a user is waiting on
+        PRIORITY_NORMAL,
+        PRIORITY_BACKGROUND   // Bulk and overnight batches
+    };
+
+    // How IMAGES_TO_KTX2 arranges its source images
+    enum TextureLayout {
+        LAYOUT_2D_ARRAY, // One array layer per image
+        LAYOUT_CUBEMAP,  // Faces +X, -X, +Y, -Y, +Z, -Z; several cubes make a cubemap array
+        LAYOUT_VOLUME    // One depth slice per image; not supported yet, such tasks fail with ERR_UNAVAILABLE
+    };
+
 private:
     int id;
+    int batch_id;
     Type type;
-    Status status;
+    // Atomic so a worker's claim and cancel() race on it safely (see try_set_status())
+    std::atomic<Status> status;
     String source_path;
     String output_path;
     Dictionary options;
     float progress;
     Error error;
     String error_message;
+    float estimated_cost;
+    Priority priority;
+    int64_t queued_usec;
+    int segment_count; // MP3 segments encoded in parallel (0 = encoded as one stream)
+
+    // Set by AssetConverter.cancel(); polled by the converter between chunks of work
+    std::atomic<bool> cancel_requested;
 
 protected:
     static void _bind_methods();
@@ -47,6 +82,7 @@ public:
 
     // Getters
     int get_id() const;
+    int get_batch_id() const;
     Type get_type() const;
     Status get_status() const;
     String get_source_path() const;
@@ -55,9 +91,14 @@ public:
     float get_progress() const;
     Error get_error() const;
     String get_error_message() const;
+    float get_estimated_cost() const;
+    Priority get_priority() const;
+    int64_t get_queued_usec() const;
+    int get_segment_count() const;
 
     // Setters (internal use)
     void set_id(int p_id);
+    void set_batch_id(int p_batch_id);
     void set_type(Type p_type);
     void set_status(Status p_status);
     void set_source_path(const String &p_path);
@@ -66,11 +107,31 @@ public:
     void set_progress(float p_progress);
     void set_error(Error p_error);
     void set_error_message(const String &p_message);
+    void set_estimated_cost(float p_cost);
+    void set_priority(Priority p_priority);
+    void set_queued_usec(int64_t p_usec);
+    void set_segment_count(int p_count);
+
+    // Move from one status to another if the task is still in the first. Workers claim
+    // a task with PENDING -> RUNNING and cancel() takes it with PENDING -> CANCELLED,
+    // so exactly one of them wins.
+    bool try_set_status(Status p_from, Status p_to);
+
+    // Cooperative cancellation (any thread)
+    void request_cancel();
+    bool is_cancel_requested() const;
+    const std::atomic<bool> *get_cancel_token() const;
 
     // Factory methods
-    static Ref<ConversionTask> create_image_to_ktx2(const String &source, const String &output, int quality = 128, bool mipmaps = true);
-    static Ref<ConversionTask> create_audio_to_mp3(const String &source, const String &output, int bitrate = 192);
-    static Ref<ConversionTask> create_glb_textures_to_ktx2(const String &source, const String &output, int quality = 128, bool mipmaps = true);
+    static Ref<ConversionTask> create_image_to_ktx2(const String &source, const String &output, int quality = 128, bool mipmaps = true,
+            Encoder encoder = ENCODER_UASTC, int compression_level = 2, int max_size = 0, float scale = 1.0f, bool pow2 = false);
+    static Ref<ConversionTask> create_images_to_ktx2(const PackedStringArray &sources, const String &output, TextureLayout layout = LAYOUT_2D_ARRAY,
+            int quality = 128, bool mipmaps = true, Encoder encoder = ENCODER_UASTC, int compression_level = 2,
+            int max_size = 0, float scale = 1.0f, bool pow2 = false);
+    static Ref<ConversionTask> create_audio_to_mp3(const String &source, const String &output, int bitrate = 192, bool parallel_segments = false);
+    static Ref<ConversionTask> create_glb_textures_to_ktx2(const String &source, const String &output, int quality = 128, bool mipmaps = true,
+            bool keep_fallback = false, Encoder encoder = ENCODER_UASTC, int compression_level = 2,
+            int max_size = 0, float scale = 1.0f, bool pow2 = false);
     static Ref<ConversionTask> create_normalize_audio(const String &source, const String &output, float target_db = -14.0f, float peak_limit_db = -1.0f);
 };
 
@@ -78,5 +139,8 @@ public:
 
 VARIANT_ENUM_CAST(ConversionTask::Type);
 VARIANT_ENUM_CAST(ConversionTask::Status);
+VARIANT_ENUM_CAST(ConversionTask::Encoder);
+VARIANT_ENUM_CAST(ConversionTask::TextureLayout);
+VARIANT_ENUM_CAST(ConversionTask::Priority);
 
 #endif // CONVERSION_TASK_H
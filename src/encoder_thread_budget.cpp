@@ -0,0 +1,187 @@
+#include "encoder_thread_budget.h"
+
+#include <godot_cpp/classes/os.hpp>
+
+#include "basisu_enc.h"
+
+using namespace godot;
+
+std::mutex EncoderThreadBudget::mutex;
+std::condition_variable EncoderThreadBudget::available_changed;
+int EncoderThreadBudget::max_threads = 0;
+int EncoderThreadBudget::available = 0;
+int EncoderThreadBudget::running_tasks = 0;
+int EncoderThreadBudget::waiting[PRIORITY_COUNT] = {};
+int EncoderThreadBudget::waiting_serial[PRIORITY_COUNT] = {};
+std::vector<std::unique_ptr<basisu::job_pool>> EncoderThreadBudget::idle_pools;
+int EncoderThreadBudget::idle_pool_threads = 0;
+
+// 0 selects the processor count
+static int resolve_max_threads(int p_count) {
+    if (p_count > 0) {
+        return p_count;
+    }
+    return MAX(1, OS::get_singleton()->get_processor_count());
+}
+
+void EncoderThreadBudget::_ensure_initialized() {
+    if (max_threads == 0) {
+        max_threads = resolve_max_threads(0);
+        available = max_threads;
+    }
+}
+
+void EncoderThreadBudget::set_max_threads(int p_count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    _ensure_initialized();
+    int new_max = resolve_max_threads(p_count);
+    // May go negative while running tasks hold more than the new limit
+    available += new_max - max_threads;
+    max_threads = new_max;
+    available_changed.notify_all();
+}
+
+int EncoderThreadBudget::get_max_threads() {
+    std::lock_guard<std::mutex> lock(mutex);
+    _ensure_initialized();
+    return max_threads;
+}
+
+void EncoderThreadBudget::begin_task() {
+    std::lock_guard<std::mutex> lock(mutex);
+    running_tasks++;
+}
+
+void EncoderThreadBudget::end_task() {
+    std::lock_guard<std::mutex> lock(mutex);
+    running_tasks--;
+}
+
+bool EncoderThreadBudget::_is_next(int p_priority, bool p_parallel) {
+    for (int priority = 0; priority < p_priority; priority++) {
+        if (waiting[priority] > 0) {
+            return false;
+        }
+    }
+    return !p_parallel || waiting_serial[p_priority] == 0;
+}
+
+int EncoderThreadBudget::acquire(bool p_parallel, ConversionTask::Priority p_priority) {
+    std::unique_lock<std::mutex> lock(mutex);
+    _ensure_initialized();
+
+    int priority = CLAMP((int)p_priority, 0, PRIORITY_COUNT - 1);
+    waiting[priority]++;
+    if (!p_parallel) {
+        waiting_serial[priority]++;
+    }
+    available_changed.wait(lock, [priority, p_parallel] { return available >= 1 && _is_next(priority, p_parallel); });
+    waiting[priority]--;
+    if (!p_parallel) {
+        waiting_serial[priority]--;
+    }
+
+    int granted = 1;
+    if (p_parallel) {
+        int fair_share = MAX(1, max_threads / MAX(1, running_tasks));
+        granted = MIN(fair_share, available);
+    }
+    available -= granted;
+    // Waiters held back for this one may go now
+    available_changed.notify_all();
+    return granted;
+}
+
+void EncoderThreadBudget::release(int p_count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    available += p_count;
+    available_changed.notify_all();
+}
+
+basisu::job_pool *EncoderThreadBudget::take_pool(int p_threads) {
+    uint32_t threads = (uint32_t)MAX(1, p_threads);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Most recently returned first, so the pools in use stay warm
+        for (size_t i = idle_pools.size(); i-- > 0;) {
+            if (idle_pools[i]->get_total_threads() == threads) {
+                basisu::job_pool *pool = idle_pools[i].release();
+                idle_pools.erase(idle_pools.begin() + i);
+                idle_pool_threads -= (int)threads;
+                return pool;
+            }
+        }
+    }
+    // No idle pool of this size: start one. It joins the idle ones when returned.
+    return new basisu::job_pool(threads);
+}
+
+void EncoderThreadBudget::return_pool(basisu::job_pool *p_pool) {
+    if (!p_pool) {
+        return;
+    }
+    std::vector<std::unique_ptr<basisu::job_pool>> stopped;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        _ensure_initialized();
+        idle_pools.emplace_back(p_pool);
+        idle_pool_threads += (int)p_pool->get_total_threads();
+        while (idle_pool_threads > max_threads && idle_pools.size() > 1) {
+            idle_pool_threads -= (int)idle_pools.front()->get_total_threads();
+            stopped.push_back(std::move(idle_pools.front()));
+            idle_pools.erase(idle_pools.begin());
+        }
+    }
+    // Pools beyond the limit join their threads here, outside the lock
+}
+
+void EncoderThreadBudget::shutdown() {
+    std::vector<std::unique_ptr<basisu::job_pool>> stopped;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped.swap(idle_pools);
+        idle_pool_threads = 0;
+    }
+}
+
+EncoderLease::EncoderLease(bool p_parallel, ConversionTask::Priority p_priority, Semaphore *p_readahead) :
+        parallel(p_parallel),
+        priority(p_priority),
+        granted(0),
+        pool(nullptr),
+        readahead(p_readahead) {
+    EncoderThreadBudget::begin_task();
+}
+
+EncoderLease::~EncoderLease() {
+    release();
+    _release_readahead();
+    EncoderThreadBudget::end_task();
+}
+
+void EncoderLease::_release_readahead() {
+    if (readahead) {
+        readahead->post();
+        readahead = nullptr;
+    }
+}
+
+basisu::job_pool *EncoderLease::acquire() {
+    if (granted == 0) {
+        granted = EncoderThreadBudget::acquire(parallel, priority);
+        pool = EncoderThreadBudget::take_pool(granted);
+        // The task now encodes, so another one may start reading ahead
+        _release_readahead();
+    }
+    return pool;
+}
+
+void EncoderLease::release() {
+    if (granted > 0) {
+        // The pool's jobs are done (callers wait for them), so it can serve another task
+        EncoderThreadBudget::return_pool(pool);
+        pool = nullptr;
+        EncoderThreadBudget::release(granted);
+        granted = 0;
+    }
+}
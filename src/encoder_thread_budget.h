@@ -0,0 +1,118 @@
+#ifndef ENCODER_THREAD_BUDGET_H
+#define ENCODER_THREAD_BUDGET_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <godot_cpp/classes/semaphore.hpp>
+
+#include "conversion_task.h"
+
+// Forward declaration (basisu headers are only included by the implementation)
+namespace basisu { class job_pool; }
+
+namespace godot {
+
+// Process-wide budget of encoder threads shared by every AssetConverter.
+// A worker acquires threads before running a task and sizes that task's Basis job
+// pool from the grant, so conversion workers plus Basis's internal jobs never use
+// more than max_threads cores in total, however many converters exist.
+//
+// The budget also owns the job pools. Pools are started once and lent out again
+// (take_pool()/return_pool()), so a task does not pay for starting and joining threads.
+// A pool is lent to one task, or one GLB image, at a time: basisu's compressor calls
+// wait_for_all() on its pool, which waits for every job in it, so a pool shared by all
+// tasks would make each encode wait for the others.
+class EncoderThreadBudget {
+private:
+    static const int PRIORITY_COUNT = 3;
+
+    static std::mutex mutex;
+    static std::condition_variable available_changed;
+    static int max_threads;
+    static int available;
+    static int running_tasks;                  // Tasks holding a lease, whether or not they hold threads yet
+    static int waiting[PRIORITY_COUNT];        // acquire() calls blocked on the budget, by priority
+    static int waiting_serial[PRIORITY_COUNT]; // The serial ones among them
+    static std::vector<std::unique_ptr<basisu::job_pool>> idle_pools; // Oldest first
+    static int idle_pool_threads;                                     // Threads of the idle pools
+
+    // Apply the processor-count default on first use. Caller holds the mutex.
+    static void _ensure_initialized();
+    // Whether no waiter is ahead of this one. Caller holds the mutex.
+    static bool _is_next(int p_priority, bool p_parallel);
+
+public:
+    // 0 selects the processor count. Running tasks keep their grant; the new
+    // limit applies as they release it.
+    static void set_max_threads(int p_count);
+    static int get_max_threads();
+
+    // A task counts towards the fair share from begin_task() to end_task(), including
+    // while it reads and decodes before acquiring
+    static void begin_task();
+    static void end_task();
+
+    // Block until at least one thread is free and return the number granted (>= 1).
+    // Waiters are served by task priority, so an interactive task never waits behind a
+    // background one for freed threads. Within a priority, serial tasks (audio) get one
+    // thread and are served before parallel ones.
+    // Parallel tasks get max_threads divided by the running tasks, so the first of
+    // several concurrent tasks does not take every thread while the others wait.
+    // A grant is fixed for the life of the task's job pool.
+    static int acquire(bool p_parallel, ConversionTask::Priority p_priority = ConversionTask::PRIORITY_NORMAL);
+    static void release(int p_count);
+
+    // Lend a pool of p_threads threads, reusing an idle one of that size if there is one.
+    // Does not draw from the budget; size it from a grant.
+    static basisu::job_pool *take_pool(int p_threads);
+    // Hand a pool back once its jobs are done. Idle pools are kept up to max_threads
+    // threads in total; older ones beyond that are stopped.
+    static void return_pool(basisu::job_pool *p_pool);
+    // Stop every idle pool (on module shutdown, after all converters are gone)
+    static void shutdown();
+};
+
+// Encoder threads held by one task for its CPU-bound stage only. The lease counts the
+// task as running (begin_task()) from construction to destruction.
+//
+// A lease may also carry a read-ahead slot the worker took before popping its task; it is
+// returned once encoder threads are granted (or when the lease ends without them). The
+// slots bound how many tasks can be reading, decoding, or holding decoded data while
+// waiting for threads, however many workers the converter runs.
+// A task reads and decodes its source before acquire() and writes its output after
+// release(), so those I/O stages run without holding any of the budget and overlap
+// the encode stage of other tasks. acquire() draws from the budget and takes a job pool
+// sized to the grant; release() (or destruction) hands the pool back and returns the
+// threads. The worker thread counts as one of them: job_pool runs jobs on the calling
+// thread while waiting.
+class EncoderLease {
+private:
+    bool parallel;
+    ConversionTask::Priority priority;
+    int granted;
+    basisu::job_pool *pool;
+    Semaphore *readahead; // Held slot, or null
+
+    void _release_readahead();
+
+public:
+    // p_priority: the task's priority when waiting for threads
+    // p_readahead: slots the task holds one of, returned to them later (null: none)
+    EncoderLease(bool p_parallel, ConversionTask::Priority p_priority, Semaphore *p_readahead = nullptr);
+    ~EncoderLease();
+
+    EncoderLease(const EncoderLease &) = delete;
+    EncoderLease &operator=(const EncoderLease &) = delete;
+
+    // Block until threads are granted. Returns the same pool while already held.
+    basisu::job_pool *acquire();
+    void release();
+    bool is_acquired() const { return granted > 0; }
+};
+
+} // namespace godot
+
+#endif // ENCODER_THREAD_BUDGET_H
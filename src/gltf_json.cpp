@@ -0,0 +1,497 @@
+#include "gltf_json.h"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace godot;
+
+// ============================================================
+// JsonWriter
+// ============================================================
+
+JsonWriter::JsonWriter(std::string &p_out) :
+        out(p_out),
+        after_key(false) {
+}
+
+void JsonWriter::_separate() {
+    if (after_key) {
+        after_key = false;
+        return;
+    }
+    if (!first_in_scope.empty()) {
+        if (!first_in_scope.back()) {
+            out.push_back(',');
+        }
+        first_in_scope.back() = false;
+    }
+}
+
+void JsonWriter::begin_object() {
+    _separate();
+    out.push_back('{');
+    first_in_scope.push_back(true);
+}
+
+void JsonWriter::end_object() {
+    out.push_back('}');
+    first_in_scope.pop_back();
+}
+
+void JsonWriter::begin_array() {
+    _separate();
+    out.push_back('[');
+    first_in_scope.push_back(true);
+}
+
+void JsonWriter::end_array() {
+    out.push_back(']');
+    first_in_scope.pop_back();
+}
+
+void JsonWriter::key(const char *name, size_t length) {
+    // Names are already escaped (copied from the source document or plain ASCII)
+    _separate();
+    out.push_back('"');
+    out.append(name, length);
+    out.append("\":");
+    after_key = true;
+}
+
+void JsonWriter::key(const char *name) {
+    key(name, strlen(name));
+}
+
+void JsonWriter::value(uint64_t number) {
+    _separate();
+    char text[24];
+    snprintf(text, sizeof(text), "%llu", (unsigned long long)number);
+    out.append(text);
+}
+
+void JsonWriter::value(const char *text) {
+    _separate();
+    out.push_back('"');
+    for (const char *c = text; *c; c++) {
+        switch (*c) {
+            case '"': out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\n': out.append("\\n"); break;
+            case '\r': out.append("\\r"); break;
+            case '\t': out.append("\\t"); break;
+            default:
+                if ((unsigned char)*c < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned)*c);
+                    out.append(escaped);
+                } else {
+                    out.push_back(*c);
+                }
+                break;
+        }
+    }
+    out.push_back('"');
+}
+
+void JsonWriter::raw_value(const char *json, size_t length) {
+    _separate();
+    out.append(json, length);
+}
+
+// ============================================================
+// GltfJsonRewriter
+// ============================================================
+
+namespace {
+
+// Tokenizer over the source document; values are located, never decoded
+struct JsonScanner {
+    const char *json;
+    size_t size;
+    size_t pos;
+
+    void skip_whitespace() {
+        while (pos < size && (json[pos] == ' ' || json[pos] == '\t' || json[pos] == '\n' || json[pos] == '\r')) {
+            pos++;
+        }
+    }
+
+    bool peek(char c) {
+        skip_whitespace();
+        return pos < size && json[pos] == c;
+    }
+
+    bool consume(char c) {
+        if (!peek(c)) {
+            return false;
+        }
+        pos++;
+        return true;
+    }
+
+    // String contents, without the quotes and still escaped
+    bool scan_string(size_t &r_start, size_t &r_end) {
+        if (!consume('"')) {
+            return false;
+        }
+        r_start = pos;
+        while (pos < size) {
+            if (json[pos] == '\\') {
+                pos += 2;
+            } else if (json[pos] == '"') {
+                r_end = pos++;
+                return true;
+            } else {
+                pos++;
+            }
+        }
+        return false;
+    }
+
+    bool skip_value(size_t &r_start, size_t &r_end) {
+        skip_whitespace();
+        r_start = pos;
+        if (pos >= size) {
+            return false;
+        }
+
+        size_t start, end;
+        if (json[pos] == '"') {
+            if (!scan_string(start, end)) {
+                return false;
+            }
+        } else if (json[pos] == '{' || json[pos] == '[') {
+            int depth = 0;
+            while (pos < size) {
+                char c = json[pos];
+                if (c == '"') {
+                    if (!scan_string(start, end)) {
+                        return false;
+                    }
+                    continue;
+                }
+                pos++;
+                if (c == '{' || c == '[') {
+                    depth++;
+                } else if ((c == '}' || c == ']') && --depth == 0) {
+                    break;
+                }
+            }
+            if (depth != 0) {
+                return false;
+            }
+        } else {
+            // Number, true, false or null
+            while (pos < size && !strchr(",}] \t\r\n", json[pos])) {
+                pos++;
+            }
+            if (pos == r_start) {
+                return false;
+            }
+        }
+        r_end = pos;
+        return true;
+    }
+
+    bool key_is(size_t start, size_t end, const char *name) {
+        size_t length = strlen(name);
+        return end - start == length && memcmp(json + start, name, length) == 0;
+    }
+};
+
+static const char *BASISU_EXTENSION = "KHR_texture_basisu";
+
+enum ArrayKind {
+    ARRAY_OTHER,
+    ARRAY_BUFFER_VIEWS,
+    ARRAY_BUFFERS,
+    ARRAY_IMAGES,
+    ARRAY_TEXTURES,
+    ARRAY_EXTENSIONS_USED,
+    ARRAY_EXTENSIONS_REQUIRED,
+};
+
+bool uses_basisu(const GltfJsonRewriter::Patch &patch) {
+    for (int64_t source : patch.texture_basisu_sources) {
+        if (source >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Extension list that must contain KHR_texture_basisu after the rewrite
+bool needs_extension_entry(ArrayKind kind, const GltfJsonRewriter::Patch &patch) {
+    if (kind == ARRAY_EXTENSIONS_USED) {
+        return uses_basisu(patch);
+    }
+    if (kind == ARRAY_EXTENSIONS_REQUIRED) {
+        return uses_basisu(patch) && !patch.keep_fallback;
+    }
+    return false;
+}
+
+void write_basisu_extension(JsonWriter &writer, int64_t source) {
+    writer.key(BASISU_EXTENSION);
+    writer.begin_object();
+    writer.key("source");
+    writer.value((uint64_t)source);
+    writer.end_object();
+}
+
+// Copy a texture's "extensions" object, replacing any KHR_texture_basisu member
+bool rewrite_texture_extensions(JsonScanner &scanner, JsonWriter &writer, int64_t source) {
+    if (!scanner.consume('{')) {
+        return false;
+    }
+    writer.begin_object();
+
+    if (!scanner.consume('}')) {
+        do {
+            size_t key_start, key_end, value_start, value_end;
+            if (!scanner.scan_string(key_start, key_end) || !scanner.consume(':') ||
+                    !scanner.skip_value(value_start, value_end)) {
+                return false;
+            }
+            if (!scanner.key_is(key_start, key_end, BASISU_EXTENSION)) {
+                writer.key(scanner.json + key_start, key_end - key_start);
+                writer.raw_value(scanner.json + value_start, value_end - value_start);
+            }
+        } while (scanner.consume(','));
+
+        if (!scanner.consume('}')) {
+            return false;
+        }
+    }
+
+    write_basisu_extension(writer, source);
+    writer.end_object();
+    return true;
+}
+
+bool rewrite_element(JsonScanner &scanner, JsonWriter &writer, ArrayKind kind, size_t index,
+        const GltfJsonRewriter::Patch &patch) {
+    bool patch_range = kind == ARRAY_BUFFER_VIEWS && index < patch.buffer_view_offsets.size();
+    bool patch_bin = kind == ARRAY_BUFFERS && index == 0;
+    bool patch_mime = kind == ARRAY_IMAGES && index < patch.image_is_ktx2.size() && patch.image_is_ktx2[index];
+    int64_t basisu_source = -1;
+    if (kind == ARRAY_TEXTURES && index < patch.texture_basisu_sources.size()) {
+        basisu_source = patch.texture_basisu_sources[index];
+    }
+    bool extensions_written = false;
+
+    if (!scanner.consume('{')) {
+        return false;
+    }
+    writer.begin_object();
+
+    // Copy members, dropping the ones the patch replaces
+    if (!scanner.consume('}')) {
+        do {
+            size_t key_start, key_end;
+            if (!scanner.scan_string(key_start, key_end) || !scanner.consume(':')) {
+                return false;
+            }
+
+            if (basisu_source >= 0 && scanner.key_is(key_start, key_end, "extensions") && scanner.peek('{')) {
+                writer.key("extensions");
+                if (!rewrite_texture_extensions(scanner, writer, basisu_source)) {
+                    return false;
+                }
+                extensions_written = true;
+                continue;
+            }
+
+            size_t value_start, value_end;
+            if (!scanner.skip_value(value_start, value_end)) {
+                return false;
+            }
+
+            bool replaced = (patch_range && (scanner.key_is(key_start, key_end, "byteOffset") ||
+                                             scanner.key_is(key_start, key_end, "byteLength"))) ||
+                            (patch_bin && scanner.key_is(key_start, key_end, "byteLength")) ||
+                            (patch_mime && scanner.key_is(key_start, key_end, "mimeType")) ||
+                            (basisu_source >= 0 && !patch.keep_fallback && scanner.key_is(key_start, key_end, "source"));
+            if (!replaced) {
+                writer.key(scanner.json + key_start, key_end - key_start);
+                writer.raw_value(scanner.json + value_start, value_end - value_start);
+            }
+        } while (scanner.consume(','));
+
+        if (!scanner.consume('}')) {
+            return false;
+        }
+    }
+
+    if (patch_range) {
+        writer.key("byteOffset");
+        writer.value(patch.buffer_view_offsets[index]);
+        writer.key("byteLength");
+        writer.value(patch.buffer_view_sizes[index]);
+    }
+    if (patch_bin) {
+        writer.key("byteLength");
+        writer.value(patch.bin_size);
+    }
+    if (patch_mime) {
+        writer.key("mimeType");
+        writer.value("image/ktx2");
+    }
+    if (basisu_source >= 0 && !extensions_written) {
+        writer.key("extensions");
+        writer.begin_object();
+        write_basisu_extension(writer, basisu_source);
+        writer.end_object();
+    }
+
+    writer.end_object();
+    return true;
+}
+
+// Elements the patch adds at the end of an array (or of a new array)
+void append_elements(JsonWriter &writer, ArrayKind kind, size_t existing_count, bool has_extension_entry,
+        const GltfJsonRewriter::Patch &patch) {
+    if (kind == ARRAY_BUFFER_VIEWS) {
+        for (size_t i = existing_count; i < patch.buffer_view_offsets.size(); i++) {
+            writer.begin_object();
+            writer.key("buffer");
+            writer.value((uint64_t)0);
+            writer.key("byteOffset");
+            writer.value(patch.buffer_view_offsets[i]);
+            writer.key("byteLength");
+            writer.value(patch.buffer_view_sizes[i]);
+            writer.end_object();
+        }
+    } else if (kind == ARRAY_IMAGES) {
+        for (uint64_t buffer_view : patch.added_ktx2_images) {
+            writer.begin_object();
+            writer.key("bufferView");
+            writer.value(buffer_view);
+            writer.key("mimeType");
+            writer.value("image/ktx2");
+            writer.end_object();
+        }
+    } else if (!has_extension_entry && needs_extension_entry(kind, patch)) {
+        writer.value(BASISU_EXTENSION);
+    }
+}
+
+bool rewrite_array(JsonScanner &scanner, JsonWriter &writer, ArrayKind kind, const GltfJsonRewriter::Patch &patch) {
+    if (!scanner.consume('[')) {
+        return false;
+    }
+    writer.begin_array();
+
+    size_t index = 0;
+    bool has_extension_entry = false;
+    if (!scanner.consume(']')) {
+        do {
+            if (scanner.peek('{')) {
+                if (!rewrite_element(scanner, writer, kind, index, patch)) {
+                    return false;
+                }
+            } else {
+                size_t value_start, value_end;
+                if (!scanner.skip_value(value_start, value_end)) {
+                    return false;
+                }
+                // Extension names are strings; compare without the quotes
+                if (value_end - value_start > 2 &&
+                        scanner.key_is(value_start + 1, value_end - 1, BASISU_EXTENSION)) {
+                    has_extension_entry = true;
+                }
+                writer.raw_value(scanner.json + value_start, value_end - value_start);
+            }
+            index++;
+        } while (scanner.consume(','));
+
+        if (!scanner.consume(']')) {
+            return false;
+        }
+    }
+
+    append_elements(writer, kind, index, has_extension_entry, patch);
+    writer.end_array();
+    return true;
+}
+
+} // namespace
+
+bool GltfJsonRewriter::rewrite(const char *json, size_t size, const Patch &patch, std::string &r_out) {
+    JsonScanner scanner = { json, size, 0 };
+    r_out.clear();
+    r_out.reserve(size + size / 8);
+    JsonWriter writer(r_out);
+
+    static const struct {
+        const char *name;
+        ArrayKind kind;
+    } rewritten_arrays[] = {
+        { "bufferViews", ARRAY_BUFFER_VIEWS },
+        { "buffers", ARRAY_BUFFERS },
+        { "images", ARRAY_IMAGES },
+        { "textures", ARRAY_TEXTURES },
+        { "extensionsUsed", ARRAY_EXTENSIONS_USED },
+        { "extensionsRequired", ARRAY_EXTENSIONS_REQUIRED },
+    };
+    bool extensions_used_seen = false;
+    bool extensions_required_seen = false;
+
+    if (!scanner.consume('{')) {
+        return false;
+    }
+    writer.begin_object();
+
+    if (!scanner.consume('}')) {
+        do {
+            size_t key_start, key_end;
+            if (!scanner.scan_string(key_start, key_end) || !scanner.consume(':')) {
+                return false;
+            }
+            writer.key(json + key_start, key_end - key_start);
+
+            ArrayKind kind = ARRAY_OTHER;
+            for (const auto &array : rewritten_arrays) {
+                if (scanner.key_is(key_start, key_end, array.name)) {
+                    kind = array.kind;
+                    break;
+                }
+            }
+
+            if (kind != ARRAY_OTHER && scanner.peek('[')) {
+                extensions_used_seen |= kind == ARRAY_EXTENSIONS_USED;
+                extensions_required_seen |= kind == ARRAY_EXTENSIONS_REQUIRED;
+                if (!rewrite_array(scanner, writer, kind, patch)) {
+                    return false;
+                }
+            } else {
+                size_t value_start, value_end;
+                if (!scanner.skip_value(value_start, value_end)) {
+                    return false;
+                }
+                writer.raw_value(json + value_start, value_end - value_start);
+            }
+        } while (scanner.consume(','));
+
+        if (!scanner.consume('}')) {
+            return false;
+        }
+    }
+
+    // Extension lists the source document did not have
+    if (!extensions_used_seen && needs_extension_entry(ARRAY_EXTENSIONS_USED, patch)) {
+        writer.key("extensionsUsed");
+        writer.begin_array();
+        writer.value(BASISU_EXTENSION);
+        writer.end_array();
+    }
+    if (!extensions_required_seen && needs_extension_entry(ARRAY_EXTENSIONS_REQUIRED, patch)) {
+        writer.key("extensionsRequired");
+        writer.begin_array();
+        writer.value(BASISU_EXTENSION);
+        writer.end_array();
+    }
+
+    writer.end_object();
+    return true;
+}
@@ -0,0 +1,69 @@
+#ifndef GLTF_JSON_H
+#define GLTF_JSON_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace godot {
+
+// Streaming JSON serializer. Values are appended to the output string in order and
+// commas are inserted automatically; nothing is buffered besides the nesting state.
+class JsonWriter {
+private:
+    std::string &out;
+    std::vector<bool> first_in_scope; // One entry per open object or array
+    bool after_key;
+
+    void _separate();
+
+public:
+    explicit JsonWriter(std::string &p_out);
+
+    void begin_object();
+    void end_object();
+    void begin_array();
+    void end_array();
+
+    void key(const char *name, size_t length);
+    void key(const char *name);
+    void value(uint64_t number);
+    void value(const char *text); // Escaped as a JSON string
+    // Already serialized JSON value, copied as is
+    void raw_value(const char *json, size_t length);
+};
+
+// Rewrites the JSON chunk of a GLB after its binary buffer has been re-laid out.
+// The document is scanned once: the elements of the top-level "bufferViews",
+// "buffers", "images" and "textures" arrays are re-serialized with the new byte
+// ranges, image MIME types and KHR_texture_basisu references, and every other value
+// is copied through verbatim, so the cost is linear in the size of the JSON and no
+// edit can hit an unrelated member.
+class GltfJsonRewriter {
+public:
+    struct Patch {
+        // New byteOffset/byteLength per buffer view (indexed like bufferViews).
+        // Entries past the existing views are appended as new views of buffer 0.
+        std::vector<uint64_t> buffer_view_offsets;
+        std::vector<uint64_t> buffer_view_sizes;
+        // New byteLength of buffer 0, the GLB BIN chunk
+        uint64_t bin_size = 0;
+        // Per image: true if its data is now KTX2
+        std::vector<bool> image_is_ktx2;
+        // KTX2 images appended after the existing ones, by buffer view index
+        std::vector<uint64_t> added_ktx2_images;
+        // Per texture: image referenced through KHR_texture_basisu, or -1 for none
+        std::vector<int64_t> texture_basisu_sources;
+        // Keep "source" on those textures as a fallback for loaders without the
+        // extension. Otherwise "source" is removed and the extension is required.
+        bool keep_fallback = false;
+    };
+
+    // Returns false if the JSON is malformed
+    static bool rewrite(const char *json, size_t size, const Patch &patch, std::string &r_out);
+};
+
+} // namespace godot
+
+#endif // GLTF_JSON_H
@@ -0,0 +1,273 @@
+#include "image_resize.h"
+
+#include "basisu_enc.h"
+#include "basisu_resampler_filters.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+using namespace godot;
+
+namespace {
+
+// Source pixels and weights contributing to each destination pixel along one axis
+struct AxisTaps {
+    std::vector<uint32_t> start; // Offsets into index/weight, one past the end for the last pixel
+    std::vector<uint32_t> index;
+    std::vector<float> weight;
+};
+
+void build_taps(uint32_t src_size, uint32_t dst_size, const basisu::resample_filter &filter, AxisTaps &r_taps) {
+    float scale = (float)src_size / (float)dst_size;
+    // Minifying widens the kernel so every source pixel contributes
+    float filter_scale = std::max(scale, 1.0f);
+    float support = filter.support * filter_scale;
+
+    r_taps.start.resize(dst_size + 1);
+    r_taps.index.clear();
+    r_taps.weight.clear();
+    for (uint32_t i = 0; i < dst_size; i++) {
+        size_t first = r_taps.index.size();
+        r_taps.start[i] = (uint32_t)first;
+
+        float center = ((float)i + 0.5f) * scale - 0.5f;
+        int left = (int)std::floor(center - support);
+        int right = (int)std::ceil(center + support);
+        float total = 0.0f;
+        for (int j = left; j <= right; j++) {
+            float w = filter.func(((float)j - center) / filter_scale);
+            if (w == 0.0f) {
+                continue;
+            }
+            // Clamp at the edges (same as repeating the border pixels)
+            r_taps.index.push_back((uint32_t)std::clamp(j, 0, (int)src_size - 1));
+            r_taps.weight.push_back(w);
+            total += w;
+        }
+
+        if (total == 0.0f) {
+            r_taps.index.resize(first);
+            r_taps.weight.resize(first);
+            r_taps.index.push_back((uint32_t)std::clamp((int)std::lround(center), 0, (int)src_size - 1));
+            r_taps.weight.push_back(1.0f);
+        } else {
+            for (size_t k = first; k < r_taps.weight.size(); k++) {
+                r_taps.weight[k] /= total;
+            }
+        }
+    }
+    r_taps.start[dst_size] = (uint32_t)r_taps.index.size();
+}
+
+// Resample a src_width x src_height image. load_row(y, row) fills row with src_width
+// RGBA floats; store(x, y, pixel) writes one destination pixel. Returns false when
+// cancelled, leaving the strips not yet started unwritten.
+template <typename LoadRow, typename Store>
+bool resample_strips(uint32_t src_width, uint32_t src_height, uint32_t dst_width, uint32_t dst_height,
+        const basisu::resample_filter &filter, basisu::job_pool *job_pool, const std::atomic<bool> *cancel_token,
+        LoadRow load_row, Store store) {
+    AxisTaps taps_x, taps_y;
+    build_taps(src_width, dst_width, filter, taps_x);
+    build_taps(src_height, dst_height, filter, taps_y);
+
+    auto is_cancelled = [cancel_token]() {
+        return cancel_token && cancel_token->load(std::memory_order_acquire);
+    };
+
+    auto run_strip = [&](uint32_t y0, uint32_t y1) {
+        // Queued strips of a cancelled task return at once, freeing the pool's threads
+        if (is_cancelled()) {
+            return;
+        }
+
+        // Source rows this strip reads
+        uint32_t first_row = src_height, last_row = 0;
+        for (uint32_t k = taps_y.start[y0]; k < taps_y.start[y1]; k++) {
+            first_row = std::min(first_row, taps_y.index[k]);
+            last_row = std::max(last_row, taps_y.index[k]);
+        }
+
+        // Horizontal pass over those rows
+        std::vector<float> source_row((size_t)src_width * 4);
+        std::vector<float> filtered((size_t)(last_row - first_row + 1) * dst_width * 4);
+        for (uint32_t sy = first_row; sy <= last_row; sy++) {
+            load_row(sy, source_row.data());
+            float *out = &filtered[(size_t)(sy - first_row) * dst_width * 4];
+            for (uint32_t dx = 0; dx < dst_width; dx++) {
+                float acc[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                for (uint32_t k = taps_x.start[dx]; k < taps_x.start[dx + 1]; k++) {
+                    const float *p = &source_row[(size_t)taps_x.index[k] * 4];
+                    float w = taps_x.weight[k];
+                    acc[0] += p[0] * w;
+                    acc[1] += p[1] * w;
+                    acc[2] += p[2] * w;
+                    acc[3] += p[3] * w;
+                }
+                memcpy(out + (size_t)dx * 4, acc, sizeof(acc));
+            }
+        }
+
+        // Vertical pass into the destination rows
+        for (uint32_t dy = y0; dy < y1; dy++) {
+            for (uint32_t dx = 0; dx < dst_width; dx++) {
+                float acc[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                for (uint32_t k = taps_y.start[dy]; k < taps_y.start[dy + 1]; k++) {
+                    const float *p = &filtered[((size_t)(taps_y.index[k] - first_row) * dst_width + dx) * 4];
+                    float w = taps_y.weight[k];
+                    acc[0] += p[0] * w;
+                    acc[1] += p[1] * w;
+                    acc[2] += p[2] * w;
+                    acc[3] += p[3] * w;
+                }
+                store(dx, dy, acc);
+            }
+        }
+    };
+
+    for (uint32_t y0 = 0; y0 < dst_height; y0 += ImageResize::STRIP_ROWS) {
+        uint32_t y1 = std::min(y0 + ImageResize::STRIP_ROWS, dst_height);
+        if (job_pool) {
+            job_pool->add_job([&run_strip, y0, y1]() { run_strip(y0, y1); });
+        } else {
+            run_strip(y0, y1);
+        }
+    }
+    if (job_pool) {
+        job_pool->wait_for_all();
+    }
+    return !is_cancelled();
+}
+
+// sRGB <-> linear conversion tables for 8-bit color
+const float *srgb_to_linear_table() {
+    static const std::vector<float> table = []() {
+        std::vector<float> t(256);
+        for (int i = 0; i < 256; i++) {
+            float c = (float)i / 255.0f;
+            t[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        return t;
+    }();
+    return table.data();
+}
+
+const int LINEAR_TO_SRGB_STEPS = 4096;
+
+const uint8_t *linear_to_srgb_table() {
+    static const std::vector<uint8_t> table = []() {
+        std::vector<uint8_t> t(LINEAR_TO_SRGB_STEPS + 1);
+        for (int i = 0; i <= LINEAR_TO_SRGB_STEPS; i++) {
+            float c = (float)i / (float)LINEAR_TO_SRGB_STEPS;
+            float s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+            t[i] = (uint8_t)std::lround(std::clamp(s, 0.0f, 1.0f) * 255.0f);
+        }
+        return t;
+    }();
+    return table.data();
+}
+
+} // namespace
+
+void ImageResize::target_size(const Settings &settings, uint32_t width, uint32_t height,
+        uint32_t &r_width, uint32_t &r_height) {
+    // Only ever downscales: a scale above 1 keeps the source size
+    double w = (double)width;
+    double h = (double)height;
+    if (settings.scale > 0.0f && settings.scale < 1.0f) {
+        w *= settings.scale;
+        h *= settings.scale;
+    }
+    double largest = std::max(w, h);
+    if (settings.max_size > 0 && largest > (double)settings.max_size) {
+        w *= (double)settings.max_size / largest;
+        h *= (double)settings.max_size / largest;
+    }
+
+    r_width = (uint32_t)std::clamp(std::lround(w), 1L, (long)std::max(1u, width));
+    r_height = (uint32_t)std::clamp(std::lround(h), 1L, (long)std::max(1u, height));
+
+    if (settings.pow2) {
+        for (auto [size, source] : { std::make_pair(&r_width, width), std::make_pair(&r_height, height) }) {
+            uint32_t pow2 = 1;
+            while (pow2 * 2 <= *size) {
+                pow2 *= 2;
+            }
+            // Nearest power of two, rounded down when rounding up would exceed the
+            // source or max_size
+            uint32_t limit = settings.max_size > 0 ? std::min(source, settings.max_size) : source;
+            if (*size - pow2 > pow2 * 2 - *size && pow2 * 2 <= limit) {
+                pow2 *= 2;
+            }
+            *size = pow2;
+        }
+    }
+}
+
+bool ImageResize::resample(const basisu::image &src, basisu::image &dst, uint32_t dst_width, uint32_t dst_height,
+        bool srgb, basisu::job_pool *job_pool, const std::atomic<bool> *cancel_token, const char *filter) {
+    int filter_index = basisu::find_resample_filter(filter);
+    if (filter_index < 0 || !src.get_width() || !src.get_height() || !dst_width || !dst_height) {
+        return false;
+    }
+
+    const float *to_linear = srgb_to_linear_table();
+    const uint8_t *to_srgb = linear_to_srgb_table();
+    const basisu::color_rgba *src_pixels = src.get_ptr();
+    uint32_t src_pitch = src.get_pitch();
+
+    dst.resize(dst_width, dst_height);
+    basisu::color_rgba *dst_pixels = dst.get_ptr();
+    uint32_t dst_pitch = dst.get_pitch();
+
+    return resample_strips(src.get_width(), src.get_height(), dst_width, dst_height,
+            basisu::g_resample_filters[filter_index], job_pool, cancel_token,
+            [&](uint32_t y, float *row) {
+                const basisu::color_rgba *p = src_pixels + (size_t)y * src_pitch;
+                for (uint32_t x = 0; x < src.get_width(); x++, p++, row += 4) {
+                    row[0] = srgb ? to_linear[p->r] : (float)p->r / 255.0f;
+                    row[1] = srgb ? to_linear[p->g] : (float)p->g / 255.0f;
+                    row[2] = srgb ? to_linear[p->b] : (float)p->b / 255.0f;
+                    row[3] = (float)p->a / 255.0f;
+                }
+            },
+            [&](uint32_t x, uint32_t y, const float *pixel) {
+                basisu::color_rgba &p = dst_pixels[(size_t)y * dst_pitch + x];
+                uint8_t *comps[3] = { &p.r, &p.g, &p.b };
+                for (int c = 0; c < 3; c++) {
+                    float v = std::clamp(pixel[c], 0.0f, 1.0f);
+                    *comps[c] = srgb ? to_srgb[(int)std::lround(v * LINEAR_TO_SRGB_STEPS)] : (uint8_t)std::lround(v * 255.0f);
+                }
+                p.a = (uint8_t)std::lround(std::clamp(pixel[3], 0.0f, 1.0f) * 255.0f);
+            });
+}
+
+bool ImageResize::resample(const basisu::imagef &src, basisu::imagef &dst, uint32_t dst_width, uint32_t dst_height,
+        basisu::job_pool *job_pool, const std::atomic<bool> *cancel_token, const char *filter) {
+    int filter_index = basisu::find_resample_filter(filter);
+    if (filter_index < 0 || !src.get_width() || !src.get_height() || !dst_width || !dst_height) {
+        return false;
+    }
+
+    const basisu::vec4F *src_pixels = src.get_ptr();
+    uint32_t src_pitch = src.get_pitch();
+
+    dst.resize(dst_width, dst_height);
+    basisu::vec4F *dst_pixels = dst.get_ptr();
+    uint32_t dst_pitch = dst.get_pitch();
+
+    return resample_strips(src.get_width(), src.get_height(), dst_width, dst_height,
+            basisu::g_resample_filters[filter_index], job_pool, cancel_token,
+            [&](uint32_t y, float *row) {
+                memcpy(row, src_pixels + (size_t)y * src_pitch, (size_t)src.get_width() * 4 * sizeof(float));
+            },
+            [&](uint32_t x, uint32_t y, const float *pixel) {
+                // Filter ringing can go negative, which the HDR encoders reject
+                basisu::vec4F &p = dst_pixels[(size_t)y * dst_pitch + x];
+                for (int c = 0; c < 4; c++) {
+                    p.m_v[c] = std::max(pixel[c], 0.0f);
+                }
+            });
+}
@@ -0,0 +1,51 @@
+#ifndef IMAGE_RESIZE_H
+#define IMAGE_RESIZE_H
+
+#include <atomic>
+#include <cstdint>
+
+// Forward declarations (basisu headers are only included by the implementation)
+namespace basisu {
+class image;
+class imagef;
+class job_pool;
+}
+
+namespace godot {
+
+// Pre-encode downscaling of texture sources.
+//
+// Images are resampled with one of basisu's filter kernels as two separable passes.
+// The destination is split into strips of rows; each strip filters the source rows it
+// needs horizontally into a private buffer and then filters those vertically, so strips
+// run as independent jobs and the intermediate buffer never holds the whole image.
+// 8-bit color is filtered in linear light when it is sRGB.
+class ImageResize {
+public:
+    struct Settings {
+        uint32_t max_size; // Largest allowed width or height (0 = unlimited)
+        float scale;       // Uniform scale applied before the max_size clamp (at most 1)
+        bool pow2;         // Round each dimension to the nearest power of two not above the source
+    };
+
+    // Destination rows per job
+    static const uint32_t STRIP_ROWS = 64;
+
+    // Size an image of width x height is resized to, never larger than the input.
+    // Equal to the input when the settings ask for no change.
+    static void target_size(const Settings &settings, uint32_t width, uint32_t height,
+            uint32_t &r_width, uint32_t &r_height);
+
+    // Resample src into dst at dst_width x dst_height. Strips run on job_pool when it is
+    // not null; the caller must not itself be running as a job of that pool.
+    // Strips not yet started are skipped once cancel_token is set, and false is returned.
+    static bool resample(const basisu::image &src, basisu::image &dst, uint32_t dst_width, uint32_t dst_height,
+            bool srgb, basisu::job_pool *job_pool, const std::atomic<bool> *cancel_token = nullptr,
+            const char *filter = "kaiser");
+    static bool resample(const basisu::imagef &src, basisu::imagef &dst, uint32_t dst_width, uint32_t dst_height,
+            basisu::job_pool *job_pool, const std::atomic<bool> *cancel_token = nullptr, const char *filter = "kaiser");
+};
+
+} // namespace godot
+
+#endif // IMAGE_RESIZE_H
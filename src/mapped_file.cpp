@@ -0,0 +1,150 @@
+#include "mapped_file.h"
+
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_POSIX
+#endif
+
+using namespace godot;
+
+MappedFile::MappedFile() :
+        data_ptr(nullptr),
+        data_size(0),
+        mapped(false)
+#ifdef _WIN32
+        ,
+        file_handle(nullptr),
+        mapping_handle(nullptr)
+#endif
+{
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::_read_fallback(const char *path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    fallback_data.resize(size);
+    if (!file.read(reinterpret_cast<char*>(fallback_data.data()), size)) {
+        fallback_data.clear();
+        return false;
+    }
+
+    data_ptr = fallback_data.data();
+    data_size = fallback_data.size();
+    return true;
+}
+
+bool MappedFile::open(const char *path) {
+    close();
+
+#ifdef _WIN32
+    int wide_length = MultiByteToWideChar(CP_UTF8, 0, path, -1, nullptr, 0);
+    std::vector<wchar_t> wide_path(wide_length > 0 ? wide_length : 1);
+    MultiByteToWideChar(CP_UTF8, 0, path, -1, wide_path.data(), wide_length);
+
+    HANDLE file = CreateFileW(wide_path.data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        return false;
+    }
+    if (file_size.QuadPart == 0) {
+        // Empty files cannot be mapped
+        CloseHandle(file);
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void *view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return _read_fallback(path);
+    }
+
+    file_handle = file;
+    mapping_handle = mapping;
+    data_ptr = (const uint8_t *)view;
+    data_size = (size_t)file_size.QuadPart;
+    mapped = true;
+    return true;
+#elif defined(MAPPED_FILE_POSIX)
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        ::close(fd);
+        return false;
+    }
+    if (file_stat.st_size == 0) {
+        // Empty files cannot be mapped
+        ::close(fd);
+        return true;
+    }
+
+    void *view = mmap(nullptr, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return _read_fallback(path);
+    }
+
+    data_ptr = (const uint8_t *)view;
+    data_size = (size_t)file_stat.st_size;
+    mapped = true;
+    return true;
+#else
+    return _read_fallback(path);
+#endif
+}
+
+void MappedFile::close() {
+    if (mapped) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_ptr);
+        CloseHandle((HANDLE)mapping_handle);
+        CloseHandle((HANDLE)file_handle);
+        mapping_handle = nullptr;
+        file_handle = nullptr;
+#elif defined(MAPPED_FILE_POSIX)
+        munmap((void *)data_ptr, data_size);
+#endif
+        mapped = false;
+    }
+
+    fallback_data.clear();
+    fallback_data.shrink_to_fit();
+    data_ptr = nullptr;
+    data_size = 0;
+}
@@ -0,0 +1,44 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace godot {
+
+// Read-only view of a whole file, memory-mapped where the platform supports it.
+// Pages are loaded on demand and shared with the OS page cache, so parsing a large
+// GLB in place does not need a private heap copy of the file. Falls back to reading
+// the file into memory when mapping is unavailable.
+class MappedFile {
+private:
+    const uint8_t *data_ptr;
+    size_t data_size;
+    bool mapped;
+#ifdef _WIN32
+    void *file_handle;
+    void *mapping_handle;
+#endif
+    std::vector<uint8_t> fallback_data;
+
+    bool _read_fallback(const char *path);
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // Path is UTF-8. The view stays valid until close() or destruction.
+    bool open(const char *path);
+    void close();
+
+    const uint8_t *data() const { return data_ptr; }
+    size_t size() const { return data_size; }
+};
+
+} // namespace godot
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,262 @@
+#include "mp3_segment_encoder.h"
+
+#include "dr_wav.h"
+#include "lame.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace godot;
+
+// PCM frames read and encoded per step within a segment
+static const size_t SEGMENT_CHUNK_FRAMES = 65536;
+
+// Layer III bitrates in kbps, indexed by [MPEG1 ? 0 : 1][bitrate index]
+static const int LAYER3_BITRATES[2][15] = {
+    { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 },
+    { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 },
+};
+
+static const int MPEG1_SAMPLE_RATES[3] = { 44100, 48000, 32000 };
+
+static void write_u32_be(uint8_t *p, uint32_t value) {
+    p[0] = (value >> 24) & 0xFF;
+    p[1] = (value >> 16) & 0xFF;
+    p[2] = (value >> 8) & 0xFF;
+    p[3] = value & 0xFF;
+}
+
+static void write_u16_be(uint8_t *p, uint16_t value) {
+    p[0] = (value >> 8) & 0xFF;
+    p[1] = value & 0xFF;
+}
+
+bool Mp3SegmentEncoder::configure(lame_global_struct *lame, const Settings &settings, bool segmented, bool write_tag) {
+    lame_set_num_channels(lame, settings.channels);
+    lame_set_in_samplerate(lame, settings.sample_rate);
+    lame_set_brate(lame, settings.bitrate);
+    lame_set_mode(lame, settings.channels == 1 ? MONO : JOINT_STEREO);
+    lame_set_quality(lame, 2); // 2 = high quality, slower
+    lame_set_bWriteVbrTag(lame, write_tag ? 1 : 0);
+    if (segmented) {
+        // Every kept frame must decode without bits borrowed from a dropped frame
+        lame_set_disable_reservoir(lame, 1);
+    }
+    return lame_init_params(lame) >= 0;
+}
+
+bool Mp3SegmentEncoder::probe(const Settings &settings, int &r_frame_samples, int &r_encoder_delay) {
+    lame_t lame = lame_init();
+    if (!lame) {
+        return false;
+    }
+
+    bool ok = configure(lame, settings, true, false) && lame_get_out_samplerate(lame) == settings.sample_rate;
+    r_frame_samples = lame_get_framesize(lame);
+    r_encoder_delay = lame_get_encoder_delay(lame);
+    lame_close(lame);
+
+    return ok && r_frame_samples > 0;
+}
+
+bool Mp3SegmentEncoder::encode_segment(const Settings &settings, int frame_samples, Segment &segment) {
+    segment.frames.clear();
+    segment.kept_frames = 0;
+
+    drwav wav;
+    if (!drwav_init_file(&wav, settings.source_path, nullptr)) {
+        segment.error = "Failed to open WAV file";
+        return false;
+    }
+
+    // Start PRIME_FRAMES early and run LOOKAHEAD_FRAMES past the end so the kept
+    // frames see the same audio on both sides as in a single-pass encode
+    uint64_t prime = segment.is_first ? 0 : PRIME_FRAMES;
+    uint64_t input_start = (segment.first_frame - prime) * frame_samples;
+    uint64_t input_end = wav.totalPCMFrameCount;
+    if (!segment.is_last) {
+        input_end = std::min<uint64_t>(input_end, (segment.first_frame + segment.frame_count + LOOKAHEAD_FRAMES) * frame_samples);
+    }
+
+    if (!drwav_seek_to_pcm_frame(&wav, input_start)) {
+        drwav_uninit(&wav);
+        segment.error = "Failed to seek in WAV file";
+        return false;
+    }
+
+    lame_t lame = lame_init();
+    if (!lame || !configure(lame, settings, true, segment.is_first)) {
+        if (lame) {
+            lame_close(lame);
+        }
+        drwav_uninit(&wav);
+        segment.error = "Failed to configure LAME encoder";
+        return false;
+    }
+
+    std::vector<int16_t> pcm_samples(SEGMENT_CHUNK_FRAMES * settings.channels);
+    std::vector<unsigned char> mp3_buffer((size_t)(1.25 * SEGMENT_CHUNK_FRAMES) + 7200);
+    std::vector<uint8_t> &encoded = segment.frames;
+
+    uint64_t position = input_start;
+    while (position < input_end) {
+        if (settings.cancel_token && settings.cancel_token->load(std::memory_order_acquire)) {
+            lame_close(lame);
+            drwav_uninit(&wav);
+            segment.error = "Cancelled";
+            return false;
+        }
+
+        uint64_t frames_to_read = std::min<uint64_t>(SEGMENT_CHUNK_FRAMES, input_end - position);
+        drwav_uint64 frames_read = drwav_read_pcm_frames_s16(&wav, frames_to_read, pcm_samples.data());
+        if (frames_read == 0) {
+            lame_close(lame);
+            drwav_uninit(&wav);
+            segment.error = "Failed to read all audio frames";
+            return false;
+        }
+
+        int mp3_size;
+        if (settings.channels == 1) {
+            mp3_size = lame_encode_buffer(lame, pcm_samples.data(), nullptr, (int)frames_read, mp3_buffer.data(), (int)mp3_buffer.size());
+        } else {
+            mp3_size = lame_encode_buffer_interleaved(lame, pcm_samples.data(), (int)frames_read, mp3_buffer.data(), (int)mp3_buffer.size());
+        }
+        if (mp3_size < 0) {
+            lame_close(lame);
+            drwav_uninit(&wav);
+            segment.error = "LAME encoding failed with error: " + std::to_string(mp3_size);
+            return false;
+        }
+        encoded.insert(encoded.end(), mp3_buffer.begin(), mp3_buffer.begin() + mp3_size);
+
+        // Report only the samples this segment is responsible for
+        uint64_t owned_start = std::max<uint64_t>(position, segment.first_frame * frame_samples);
+        position += frames_read;
+        if (settings.on_samples_encoded && position > owned_start) {
+            uint64_t owned_end = segment.is_last ? position : std::min<uint64_t>(position, (segment.first_frame + segment.frame_count) * frame_samples);
+            if (owned_end > owned_start) {
+                settings.on_samples_encoded(owned_end - owned_start);
+            }
+        }
+    }
+    drwav_uninit(&wav);
+
+    int flush_size = lame_encode_flush(lame, mp3_buffer.data(), (int)mp3_buffer.size());
+    if (flush_size > 0) {
+        encoded.insert(encoded.end(), mp3_buffer.begin(), mp3_buffer.begin() + flush_size);
+    }
+
+    // The first segment's encoder emitted a placeholder tag frame; keep its final form
+    if (segment.is_first) {
+        segment.tag_frame.resize(lame_get_lametag_frame(lame, nullptr, 0));
+        if (!segment.tag_frame.empty()) {
+            lame_get_lametag_frame(lame, segment.tag_frame.data(), segment.tag_frame.size());
+        }
+    }
+    lame_close(lame);
+
+    // Walk the frames and keep [prime, prime + frame_count)
+    size_t offset = segment.tag_frame.empty() ? 0 : frame_length(encoded.data(), encoded.size());
+    size_t keep_start = 0;
+    size_t keep_end = 0;
+    uint64_t frame_index = 0;
+    while (offset < encoded.size()) {
+        size_t length = frame_length(encoded.data() + offset, encoded.size() - offset);
+        if (length == 0) {
+            segment.error = "Encoder produced an invalid MP3 frame";
+            return false;
+        }
+        if (frame_index == prime) {
+            keep_start = offset;
+        }
+        offset += length;
+        frame_index++;
+        if (frame_index > prime) {
+            keep_end = offset;
+            segment.kept_frames++;
+        }
+        if (!segment.is_last && segment.kept_frames == segment.frame_count) {
+            break;
+        }
+    }
+
+    if (!segment.is_last && segment.kept_frames < segment.frame_count) {
+        segment.error = "Encoder produced too few MP3 frames for segment";
+        return false;
+    }
+
+    encoded.resize(keep_end);
+    encoded.erase(encoded.begin(), encoded.begin() + keep_start);
+    encoded.shrink_to_fit();
+    return true;
+}
+
+void Mp3SegmentEncoder::finalize_tag_frame(std::vector<uint8_t> &tag_frame, uint32_t music_frames,
+        uint64_t music_bytes, uint16_t music_crc, int encoder_delay, int encoder_padding) {
+    // The Xing/Info header follows the side info; find its magic
+    size_t xing = 0;
+    for (size_t i = 4; i + 4 <= std::min<size_t>(tag_frame.size(), 48); i++) {
+        if (memcmp(&tag_frame[i], "Info", 4) == 0 || memcmp(&tag_frame[i], "Xing", 4) == 0) {
+            xing = i;
+            break;
+        }
+    }
+    if (xing == 0 || xing + 156 > tag_frame.size()) {
+        return;
+    }
+
+    uint64_t stream_size = music_bytes + tag_frame.size();
+
+    write_u32_be(&tag_frame[xing + 8], music_frames);
+    write_u32_be(&tag_frame[xing + 12], (uint32_t)stream_size);
+
+    // Constant bitrate: the seek table is linear
+    for (int i = 0; i < 100; i++) {
+        tag_frame[xing + 16 + i] = (uint8_t)std::min(255, i * 256 / 100);
+    }
+
+    // LAME extension: encoder delay and padding (12 bits each)
+    encoder_delay = std::max(0, std::min(encoder_delay, 4095));
+    encoder_padding = std::max(0, std::min(encoder_padding, 4095));
+    tag_frame[xing + 141] = (uint8_t)(encoder_delay >> 4);
+    tag_frame[xing + 142] = (uint8_t)(((encoder_delay & 0x0F) << 4) | (encoder_padding >> 8));
+    tag_frame[xing + 143] = (uint8_t)(encoder_padding & 0xFF);
+
+    write_u32_be(&tag_frame[xing + 148], (uint32_t)stream_size);
+    write_u16_be(&tag_frame[xing + 152], music_crc);
+    write_u16_be(&tag_frame[xing + 154], crc16(tag_frame.data(), xing + 154, 0));
+}
+
+size_t Mp3SegmentEncoder::frame_length(const uint8_t *data, size_t available) {
+    if (available < 4 || data[0] != 0xFF || (data[1] & 0xE0) != 0xE0) {
+        return 0;
+    }
+
+    int version = (data[1] >> 3) & 0x03; // 0 = MPEG2.5, 2 = MPEG2, 3 = MPEG1
+    int layer = (data[1] >> 1) & 0x03; // 1 = Layer III
+    int bitrate_index = data[2] >> 4;
+    int sample_rate_index = (data[2] >> 2) & 0x03;
+    int padding = (data[2] >> 1) & 0x01;
+
+    if (version == 1 || layer != 1 || bitrate_index == 0 || bitrate_index == 15 || sample_rate_index == 3) {
+        return 0;
+    }
+
+    bool mpeg1 = version == 3;
+    int bitrate = LAYER3_BITRATES[mpeg1 ? 0 : 1][bitrate_index] * 1000;
+    int sample_rate = MPEG1_SAMPLE_RATES[sample_rate_index] >> (mpeg1 ? 0 : (version == 2 ? 1 : 2));
+
+    size_t length = (size_t)((mpeg1 ? 144 : 72) * bitrate / sample_rate + padding);
+    return length <= available ? length : 0;
+}
+
+uint16_t Mp3SegmentEncoder::crc16(const uint8_t *data, size_t size, uint16_t crc) {
+    for (size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (uint16_t)((crc >> 1) ^ 0xA001) : (uint16_t)(crc >> 1);
+        }
+    }
+    return crc;
+}
@@ -0,0 +1,82 @@
+#ifndef MP3_SEGMENT_ENCODER_H
+#define MP3_SEGMENT_ENCODER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Forward declaration (lame.h is only included by the implementation)
+struct lame_global_struct;
+
+namespace godot {
+
+// Segment-parallel MP3 encoding.
+//
+// A long WAV is split on MP3 frame boundaries and each segment is encoded by its own
+// LAME instance. Segments after the first start PRIME_FRAMES early and drop those
+// frames, so the encoder delay and MDCT overlap are fed with real audio and the kept
+// frames line up sample-exactly with a single-pass encode (no gaps or clicks at the
+// seams). The bit reservoir is disabled so every kept frame is self-contained.
+// The first segment also produces the LAME tag frame, which is patched with the
+// totals of the stitched stream.
+class Mp3SegmentEncoder {
+public:
+    struct Settings {
+        const char *source_path;
+        int channels;
+        int sample_rate;
+        int bitrate;
+
+        // Called from the encoding thread after each block of input samples
+        std::function<void(uint64_t)> on_samples_encoded;
+
+        // Polled before each block; when set, encode_segment() stops and fails (optional)
+        const std::atomic<bool> *cancel_token = nullptr;
+    };
+
+    struct Segment {
+        uint64_t first_frame; // First MP3 frame of this segment in the whole stream
+        uint64_t frame_count; // Frames to keep (ignored for the last segment)
+        bool is_first;
+        bool is_last;
+
+        std::vector<uint8_t> frames; // Encoded frames, tag frame excluded
+        uint32_t kept_frames;
+        std::vector<uint8_t> tag_frame; // LAME tag template (first segment only)
+        std::string error;
+    };
+
+    // Frames encoded before a segment's first kept frame
+    static const int PRIME_FRAMES = 2;
+    // Frames encoded past a segment's last kept frame before flushing
+    static const int LOOKAHEAD_FRAMES = 2;
+
+    // Configure a LAME instance and call lame_init_params(). Segmented encodes disable
+    // the bit reservoir. Returns false if the parameters are rejected.
+    static bool configure(lame_global_struct *lame, const Settings &settings, bool segmented, bool write_tag);
+
+    // Samples per MP3 frame and encoder delay at the given settings. Returns false if
+    // the stream cannot be split sample-exactly (LAME would resample the input).
+    static bool probe(const Settings &settings, int &r_frame_samples, int &r_encoder_delay);
+
+    // Encode one segment. Safe to call from several threads at once.
+    static bool encode_segment(const Settings &settings, int frame_samples, Segment &segment);
+
+    // Fill in frame count, stream size, TOC, padding and CRCs of a LAME tag frame
+    // for the stitched stream that follows it.
+    static void finalize_tag_frame(std::vector<uint8_t> &tag_frame, uint32_t music_frames,
+            uint64_t music_bytes, uint16_t music_crc, int encoder_delay, int encoder_padding);
+
+    // Length in bytes of the MPEG audio frame starting at data, or 0 if there is none
+    static size_t frame_length(const uint8_t *data, size_t available);
+
+    // CRC-16 as used by the LAME tag (polynomial 0x8005, reflected)
+    static uint16_t crc16(const uint8_t *data, size_t size, uint16_t crc);
+};
+
+} // namespace godot
+
+#endif // MP3_SEGMENT_ENCODER_H
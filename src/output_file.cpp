@@ -0,0 +1,86 @@
+#include "output_file.h"
+
+#include <atomic>
+#include <cstdio>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <vector>
+#else
+#include <unistd.h>
+#endif
+
+using namespace godot;
+
+// Distinguishes temporary files of concurrent tasks writing next to each other
+static std::atomic<uint32_t> temp_file_counter(0);
+
+// Distinguishes temporary files of processes writing to the same directory (for
+// example several editor or export instances converting the same project)
+static unsigned long current_process_id() {
+#ifdef _WIN32
+    return (unsigned long)GetCurrentProcessId();
+#else
+    return (unsigned long)getpid();
+#endif
+}
+
+#ifdef _WIN32
+static std::vector<wchar_t> utf8_to_wide(const std::string &text) {
+    int length = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), -1, nullptr, 0);
+    std::vector<wchar_t> wide(length > 0 ? length : 1);
+    MultiByteToWideChar(CP_UTF8, 0, text.c_str(), -1, wide.data(), length);
+    return wide;
+}
+#endif
+
+OutputFile::OutputFile(const char *p_path) :
+        path(p_path),
+        committed(false) {
+    temp_path = path + ".tmp" + std::to_string(current_process_id()) + "." + std::to_string(temp_file_counter.fetch_add(1));
+}
+
+OutputFile::~OutputFile() {
+    if (!committed) {
+        if (file.is_open()) {
+            file.close();
+        }
+        std::remove(temp_path.c_str());
+    }
+}
+
+bool OutputFile::open() {
+    file.open(temp_path, std::ios::binary | std::ios::trunc);
+    return file.is_open();
+}
+
+bool OutputFile::commit() {
+    if (file.is_open()) {
+        file.close();
+        if (!file.good()) {
+            return false;
+        }
+    }
+
+#ifdef _WIN32
+    std::vector<wchar_t> wide_temp = utf8_to_wide(temp_path);
+    std::vector<wchar_t> wide_path = utf8_to_wide(path);
+    if (!MoveFileExW(wide_temp.data(), wide_path.data(), MOVEFILE_REPLACE_EXISTING)) {
+        return false;
+    }
+#else
+    // rename() replaces an existing destination atomically
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        return false;
+    }
+#endif
+
+    committed = true;
+    return true;
+}
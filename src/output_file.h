@@ -0,0 +1,43 @@
+#ifndef OUTPUT_FILE_H
+#define OUTPUT_FILE_H
+
+#include <fstream>
+#include <string>
+
+namespace godot {
+
+// Atomic output file. Data goes to a temporary file next to the destination, which
+// commit() renames over the destination. Until then the destination is untouched, so
+// a failed or cancelled task never leaves a half-written output behind; the temporary
+// file is removed if the writer is destroyed without committing. Temporary names carry
+// the process ID and a per-process counter, so writers in different processes never
+// share one.
+class OutputFile {
+private:
+    std::string path;
+    std::string temp_path;
+    std::ofstream file;
+    bool committed;
+
+public:
+    // Path is UTF-8
+    explicit OutputFile(const char *p_path);
+    ~OutputFile();
+
+    OutputFile(const OutputFile &) = delete;
+    OutputFile &operator=(const OutputFile &) = delete;
+
+    // Open the temporary file for writing through stream()
+    bool open();
+    std::ofstream &stream() { return file; }
+
+    // For writers that open the file themselves (e.g. dr_wav)
+    const char *get_temp_path() const { return temp_path.c_str(); }
+
+    // Close the stream if open and move the temporary file over the destination
+    bool commit();
+};
+
+} // namespace godot
+
+#endif // OUTPUT_FILE_H
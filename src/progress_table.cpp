@@ -0,0 +1,58 @@
+#include "progress_table.h"
+
+using namespace godot;
+
+ProgressTable::ProgressTable(int p_slot_count) :
+        slot_count(0),
+        last_pump_usec(0),
+        pump_pending(false),
+        pump_missed(false) {
+    resize(p_slot_count);
+}
+
+void ProgressTable::resize(int p_slot_count) {
+    if (p_slot_count < 1) {
+        p_slot_count = 1;
+    }
+    slots.reset(new Slot[p_slot_count]);
+    slot_count = p_slot_count;
+    for (int i = 0; i < slot_count; i++) {
+        slots[i].task_id = -1;
+        slots[i].progress = 0.0f;
+        slots[i].drained_task = -1;
+        slots[i].drained_progress = 0.0f;
+    }
+}
+
+void ProgressTable::begin(int slot, int task_id) {
+    Slot &s = slots[slot % slot_count];
+    s.progress.store(0.0f, std::memory_order_release);
+    s.task_id.store(task_id, std::memory_order_release);
+}
+
+void ProgressTable::end(int slot) {
+    slots[slot % slot_count].task_id.store(-1, std::memory_order_release);
+}
+
+void ProgressTable::set(int task_id, float progress) {
+    // A handful of slots (one per worker): a scan is cheaper than any lookup structure
+    for (int i = 0; i < slot_count; i++) {
+        if (slots[i].task_id.load(std::memory_order_relaxed) == task_id) {
+            slots[i].progress.store(progress, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+bool ProgressTable::request_pump(int64_t now_usec) {
+    if (now_usec - last_pump_usec.load() < 1000000 / MAX_PUMP_HZ) {
+        pump_missed = true;
+        return false;
+    }
+    bool expected = false;
+    return pump_pending.compare_exchange_strong(expected, true);
+}
+
+bool ProgressTable::is_pump_overdue(int64_t now_usec) const {
+    return pump_missed.load() && !pump_pending.load() && now_usec - last_pump_usec.load() >= 1000000 / MAX_PUMP_HZ;
+}
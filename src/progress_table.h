@@ -0,0 +1,86 @@
+#ifndef PROGRESS_TABLE_H
+#define PROGRESS_TABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace godot {
+
+// Latest progress of the running tasks, one slot per worker.
+// Workers publish with atomic stores and never block or allocate; the main thread
+// drains the slots at most MAX_PUMP_HZ times per second, so a task may report any
+// number of updates but only the newest value per drain reaches the signal queue.
+class ProgressTable {
+public:
+    static const int MAX_PUMP_HZ = 30;
+
+private:
+    struct Slot {
+        std::atomic<int> task_id;
+        std::atomic<float> progress;
+
+        // Main thread only: last value handed to the visitor
+        int drained_task;
+        float drained_progress;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    int slot_count;
+
+    std::atomic<int64_t> last_pump_usec;
+    std::atomic<bool> pump_pending;
+    std::atomic<bool> pump_missed;
+
+public:
+    explicit ProgressTable(int p_slot_count = 1);
+
+    // Change the number of slots. Workers must be stopped.
+    void resize(int p_slot_count);
+
+    // Bind a worker's slot to the task it runs, and clear it when the task ends
+    void begin(int slot, int task_id);
+    void end(int slot);
+
+    // Publish a running task's progress (any thread, including the task's jobs)
+    void set(int task_id, float progress);
+
+    // Whether the caller should schedule a pump now: true at most once per interval
+    // while no pump is pending. Otherwise the update is left for the next pump.
+    bool request_pump(int64_t now_usec);
+
+    // Whether an update has waited for a pump longer than the interval
+    bool is_pump_overdue(int64_t now_usec) const;
+
+    // Main thread. Visit (task_id, progress) for every slot that changed since the last
+    // drain. The visitor returns false to keep the update for a later drain.
+    template <typename Visitor>
+    void drain(int64_t now_usec, Visitor visitor) {
+        pump_pending = false;
+        pump_missed = false;
+        last_pump_usec = now_usec;
+        for (int i = 0; i < slot_count; i++) {
+            Slot &slot = slots[i];
+            int task_id = slot.task_id.load(std::memory_order_acquire);
+            float progress = slot.progress.load(std::memory_order_acquire);
+            if (task_id < 0 || (task_id == slot.drained_task && progress == slot.drained_progress)) {
+                continue;
+            }
+            // The worker moved on to another task while the slot was read
+            if (slot.task_id.load(std::memory_order_acquire) != task_id) {
+                pump_missed = true;
+                continue;
+            }
+            if (visitor(task_id, progress)) {
+                slot.drained_task = task_id;
+                slot.drained_progress = progress;
+            } else {
+                pump_missed = true;
+            }
+        }
+    }
+};
+
+} // namespace godot
+
+#endif // PROGRESS_TABLE_H
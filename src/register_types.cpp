@@ -4,6 +4,7 @@
 #include "asset_converter.h"
 #include "asset_probe.h"
 #include "conversion_task.h"
+#include "encoder_thread_budget.h"
 
 #include <gdextension_interface.h>
 #include <godot_cpp/core/defs.hpp>
@@ -26,6 +27,9 @@ void uninitialize_gdassetop_module(ModuleInitializationLevel p_level) {
     if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
         return;
     }
+
+    // Join the encoder threads kept idle between tasks
+    EncoderThreadBudget::shutdown();
 }
 
 extern "C" {
@@ -0,0 +1,47 @@
+#include "shared_texture_cache.h"
+#include "conversion_cache.h"
+
+#include <cstdio>
+
+using namespace godot;
+
+std::string SharedTextureCache::make_key(const uint8_t *payload, size_t size, const std::string &options) {
+    // Two independently seeded hashes plus the size, so a collision would need to
+    // match 128 bits of hash on payloads of equal length
+    uint64_t hash_a = ConversionCache::hash64(payload, size, 0);
+    uint64_t hash_b = ConversionCache::hash64(payload, size, 0x9E3779B97F4A7C15ULL);
+
+    char key[64];
+    snprintf(key, sizeof(key), "%016llx%016llx-%llx", (unsigned long long)hash_a,
+            (unsigned long long)hash_b, (unsigned long long)size);
+    return std::string(key) + "|" + options;
+}
+
+bool SharedTextureCache::acquire(const std::string &key, Blob &r_blob) {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    auto it = slots.find(key);
+    if (it == slots.end()) {
+        slots.emplace(key, std::make_shared<Slot>());
+        return true;
+    }
+
+    // Keep the slot alive while waiting
+    std::shared_ptr<Slot> slot = it->second;
+    ready_condition.wait(lock, [&slot]() { return slot->ready; });
+    r_blob = slot->blob;
+    return false;
+}
+
+void SharedTextureCache::publish(const std::string &key, const Blob &blob) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = slots.find(key);
+        if (it == slots.end()) {
+            return;
+        }
+        it->second->blob = blob;
+        it->second->ready = true;
+    }
+    ready_condition.notify_all();
+}
@@ -0,0 +1,49 @@
+#ifndef SHARED_TEXTURE_CACHE_H
+#define SHARED_TEXTURE_CACHE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace godot {
+
+// Encoded textures shared by every GLB of a batch.
+// Entries are keyed by the content of the embedded image payload and the encode
+// options, so an image embedded in several GLBs is encoded once. The first job to
+// ask for a key claims it and encodes; later jobs for the same key wait for that
+// result instead of encoding it again. AssetConverter keeps one cache per batch and
+// drops it with the batch's last task, so entries never outlive the batch.
+class SharedTextureCache {
+public:
+    // Encoded KTX2 file, or null if the image could not be converted
+    typedef std::shared_ptr<const std::vector<uint8_t>> Blob;
+
+private:
+    struct Slot {
+        bool ready = false;
+        Blob blob;
+    };
+
+    std::mutex mutex;
+    std::condition_variable ready_condition;
+    std::unordered_map<std::string, std::shared_ptr<Slot>> slots;
+
+public:
+    // Key for an image payload encoded with the given options
+    static std::string make_key(const uint8_t *payload, size_t size, const std::string &options);
+
+    // Returns true if the caller claimed the key and must publish() the result.
+    // Otherwise r_blob is set to the result of the claiming job, waiting for it if
+    // that job is still encoding.
+    bool acquire(const std::string &key, Blob &r_blob);
+    void publish(const std::string &key, const Blob &blob);
+};
+
+} // namespace godot
+
+#endif // SHARED_TEXTURE_CACHE_H
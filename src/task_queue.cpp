@@ -0,0 +1,206 @@
+#include "task_queue.h"
+
+#include <algorithm>
+
+using namespace godot;
+
+TaskQueue::TaskQueue(int worker_count) :
+        deque_count(0),
+        push_count(0),
+        next_deque(0),
+        task_count(0) {
+    for (int lane = 0; lane < LANE_COUNT; lane++) {
+        lane_counts[lane] = 0;
+    }
+    reset_wait_stats();
+    set_worker_count(worker_count);
+}
+
+void TaskQueue::set_worker_count(int worker_count) {
+    worker_count = std::clamp(worker_count, 1, MAX_WORKERS);
+
+    // New deques are constructed before the count that publishes them
+    int allocated = deque_count.load();
+    for (int i = allocated; i < worker_count; i++) {
+        deques[i] = std::make_unique<WorkerDeque>();
+    }
+    if (worker_count > allocated) {
+        deque_count.store(worker_count, std::memory_order_release);
+    }
+    push_count.store(worker_count, std::memory_order_release);
+}
+
+int TaskQueue::_lane_of(const Ref<ConversionTask> &task) {
+    return std::clamp((int)task->get_priority(), 0, LANE_COUNT - 1);
+}
+
+void TaskQueue::push(const Ref<ConversionTask> &task, int64_t now_usec) {
+    task->set_queued_usec(now_usec);
+
+    uint32_t index = next_deque.fetch_add(1) % (uint32_t)push_count.load(std::memory_order_acquire);
+    WorkerDeque &deque = *deques[index];
+    int lane = _lane_of(task);
+
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    deque.lanes[lane].push_back(task);
+    deque.count++;
+    _update_oldest(deque);
+    lane_counts[lane]++;
+    task_count++;
+}
+
+void TaskQueue::_update_oldest(WorkerDeque &deque) {
+    int64_t oldest = INT64_MAX;
+    for (const std::deque<Ref<ConversionTask>> &lane : deque.lanes) {
+        if (!lane.empty()) {
+            oldest = std::min(oldest, lane.front()->get_queued_usec());
+        }
+    }
+    deque.oldest_usec.store(oldest);
+}
+
+TaskQueue::Candidate TaskQueue::_aged_front(WorkerDeque &deque, int64_t now_usec) {
+    Candidate best;
+    if (deque.count.load() == 0) {
+        return best;
+    }
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    for (int lane = 0; lane < LANE_COUNT; lane++) {
+        if (deque.lanes[lane].empty()) {
+            continue;
+        }
+        int64_t queued_usec = deque.lanes[lane].front()->get_queued_usec();
+        int effective = (int)std::max<int64_t>(0, lane - (now_usec - queued_usec) / AGING_USEC);
+        // Ties go to the task that has waited longest, so an aged task runs ahead of
+        // fresh ones queued in the lane it has reached
+        if (effective < best.lane || (effective == best.lane && queued_usec < best.queued_usec)) {
+            best.lane = effective;
+            best.source_lane = lane;
+            best.queued_usec = queued_usec;
+        }
+    }
+    return best;
+}
+
+bool TaskQueue::_pop_front(WorkerDeque &deque, int lane, Ref<ConversionTask> &r_task) {
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    if (deque.lanes[lane].empty()) {
+        return false;
+    }
+    r_task = deque.lanes[lane].front();
+    deque.lanes[lane].pop_front();
+    deque.count--;
+    _update_oldest(deque);
+    lane_counts[lane]--;
+    task_count--;
+    return true;
+}
+
+bool TaskQueue::_pop_back(WorkerDeque &deque, int lane, Ref<ConversionTask> &r_task) {
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    if (deque.lanes[lane].empty()) {
+        return false;
+    }
+    r_task = deque.lanes[lane].back();
+    deque.lanes[lane].pop_back();
+    deque.count--;
+    _update_oldest(deque);
+    lane_counts[lane]--;
+    task_count--;
+    return true;
+}
+
+void TaskQueue::_record_wait(int lane, int64_t wait_usec) {
+    LaneStats &stats = lane_stats[lane];
+    stats.tasks++;
+    stats.total_usec += wait_usec;
+    int64_t max_usec = stats.max_usec.load();
+    while (wait_usec > max_usec && !stats.max_usec.compare_exchange_weak(max_usec, wait_usec)) {
+    }
+}
+
+Ref<ConversionTask> TaskQueue::pop(int worker_index, int64_t now_usec) {
+    Ref<ConversionTask> task;
+    int deque_count = this->deque_count.load(std::memory_order_acquire);
+    int own = worker_index % deque_count;
+
+    auto take = [&](int lane) {
+        _record_wait(lane, now_usec - task->get_queued_usec());
+        return task;
+    };
+
+    // Task this worker would serve from its own deque
+    Candidate best = _aged_front(*deques[own], now_usec);
+    int best_deque = own;
+
+    // Another deque wins with a higher effective lane, or with an aged task older than
+    // the current choice in the same lane. Otherwise the worker keeps to its own deque.
+    // A deque is only locked if it may hold a higher lane (per the lane counts) or a
+    // task old enough to have aged, so while nothing has waited AGING_USEC a worker with
+    // work of its own locks no other deque.
+    bool higher_lane_queued = false;
+    for (int lane = 0; lane < best.lane && lane < LANE_COUNT; lane++) {
+        higher_lane_queued = higher_lane_queued || lane_counts[lane].load() > 0;
+    }
+    for (int i = 1; i < deque_count; i++) {
+        int index = (own + i) % deque_count;
+        WorkerDeque &deque = *deques[index];
+        if (!higher_lane_queued && now_usec - deque.oldest_usec.load() < AGING_USEC) {
+            continue;
+        }
+        Candidate candidate = _aged_front(deque, now_usec);
+        if (candidate.lane < best.lane ||
+            (candidate.lane == best.lane && candidate.is_aged() && candidate.queued_usec < best.queued_usec)) {
+            best = candidate;
+            best_deque = index;
+        }
+    }
+
+    // Own deque and aged tasks come off the front (oldest first); other steals take the
+    // back, away from the owning worker
+    if (best.source_lane < LANE_COUNT) {
+        WorkerDeque &deque = *deques[best_deque];
+        bool from_front = best_deque == own || best.is_aged();
+        if (from_front ? _pop_front(deque, best.source_lane, task) : _pop_back(deque, best.source_lane, task)) {
+            return take(best.source_lane);
+        }
+    }
+
+    // The deques changed while they were scanned: take anything, highest lane first
+    for (int lane = 0; lane < LANE_COUNT; lane++) {
+        if (lane_counts[lane].load() == 0) {
+            continue;
+        }
+        if (_pop_front(*deques[own], lane, task)) {
+            return take(lane);
+        }
+        for (int i = 1; i < deque_count; i++) {
+            if (_pop_back(*deques[(own + i) % deque_count], lane, task)) {
+                return take(lane);
+            }
+        }
+    }
+
+    return task;
+}
+
+int TaskQueue::size() const {
+    return task_count.load();
+}
+
+bool TaskQueue::is_empty() const {
+    return task_count.load() == 0;
+}
+
+TaskQueue::WaitStats TaskQueue::get_wait_stats(ConversionTask::Priority priority) const {
+    const LaneStats &stats = lane_stats[std::clamp((int)priority, 0, LANE_COUNT - 1)];
+    return WaitStats{ stats.tasks.load(), stats.total_usec.load(), stats.max_usec.load() };
+}
+
+void TaskQueue::reset_wait_stats() {
+    for (LaneStats &stats : lane_stats) {
+        stats.tasks = 0;
+        stats.total_usec = 0;
+        stats.max_usec = 0;
+    }
+}
@@ -0,0 +1,106 @@
+#ifndef TASK_QUEUE_H
+#define TASK_QUEUE_H
+
+#include "conversion_task.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace godot {
+
+// Work-stealing task queue with one deque per worker and priority lane.
+// Tasks are pushed round-robin; a worker pops from the front of its own deque and,
+// when that is empty, steals from the back of the others. Push and pop are O(1) and
+// only lock a single deque, so workers do not contend on one global queue lock.
+// Deques are allocated up to the largest worker count seen and never freed, so the
+// pool can grow and shrink while workers run; a deque whose worker has retired stops
+// receiving tasks and is drained by stealing.
+//
+// Each deque holds one FIFO per ConversionTask::Priority, and a worker always takes
+// the highest lane that has work anywhere before a lower one. To keep a long stream
+// of higher work from starving a lane, the task at the front of each lane is promoted
+// one lane for every AGING_USEC it has waited, up to PRIORITY_INTERACTIVE. Aging
+// applies to every deque a worker considers, including those it steals from, and an
+// aged task goes ahead of any newer task in the lane it has reached, so a task queued
+// on a busy worker's deque is still taken by the others. A fresh interactive task still
+// overtakes lower work that has not aged into its lane, but no task waits behind newer
+// work indefinitely.
+class TaskQueue {
+public:
+    static const int MAX_WORKERS = 256;
+    static const int LANE_COUNT = 3;
+    static const int64_t AGING_USEC = 5000000;
+
+    // Time tasks of one lane spent queued before a worker took them
+    struct WaitStats {
+        int64_t tasks;
+        int64_t total_usec;
+        int64_t max_usec;
+    };
+
+private:
+    struct WorkerDeque {
+        std::mutex mutex;
+        std::deque<Ref<ConversionTask>> lanes[LANE_COUNT];
+        // Read without the lock, so a worker only locks deques that could give it a task
+        std::atomic<int> count{ 0 };                    // Tasks in all lanes
+        std::atomic<int64_t> oldest_usec{ INT64_MAX }; // Queue time of the oldest lane front
+    };
+
+    // The task a deque would give up next, after aging
+    struct Candidate {
+        int lane = LANE_COUNT;        // Effective lane (LANE_COUNT if the deque is empty)
+        int source_lane = LANE_COUNT; // Lane the task is queued in
+        int64_t queued_usec = 0;
+
+        bool is_aged() const { return lane < source_lane; }
+    };
+
+    struct LaneStats {
+        std::atomic<int64_t> tasks;
+        std::atomic<int64_t> total_usec;
+        std::atomic<int64_t> max_usec;
+    };
+
+    std::unique_ptr<WorkerDeque> deques[MAX_WORKERS];
+    std::atomic<int> deque_count; // Allocated deques
+    std::atomic<int> push_count;  // Deques that receive new tasks (the active workers)
+    std::atomic<uint32_t> next_deque;
+    std::atomic<int> task_count;
+    std::atomic<int> lane_counts[LANE_COUNT];
+    LaneStats lane_stats[LANE_COUNT];
+
+    static int _lane_of(const Ref<ConversionTask> &task);
+    // Front task of the deque's highest lane after aging; ties go to the oldest
+    Candidate _aged_front(WorkerDeque &deque, int64_t now_usec);
+    // Refresh deque.oldest_usec; caller holds the deque's lock
+    static void _update_oldest(WorkerDeque &deque);
+    bool _pop_front(WorkerDeque &deque, int lane, Ref<ConversionTask> &r_task);
+    bool _pop_back(WorkerDeque &deque, int lane, Ref<ConversionTask> &r_task);
+    void _record_wait(int lane, int64_t wait_usec);
+
+public:
+    explicit TaskQueue(int worker_count = 1);
+
+    // Set the number of active workers (at most MAX_WORKERS). Safe while workers run;
+    // must not be called from several threads at once.
+    void set_worker_count(int worker_count);
+
+    // Queue a task in the lane of its priority; now_usec stamps its queue time
+    void push(const Ref<ConversionTask> &task, int64_t now_usec);
+    Ref<ConversionTask> pop(int worker_index, int64_t now_usec);
+
+    int size() const;
+    bool is_empty() const;
+
+    WaitStats get_wait_stats(ConversionTask::Priority priority) const;
+    void reset_wait_stats();
+};
+
+} // namespace godot
+
+#endif // TASK_QUEUE_H
@@ -0,0 +1,59 @@
+extends SceneTree
+## Task queue throughput benchmark for AssetConverter
+##
+## Run with: godot --headless --script test/bench_task_queue.gd
+##
+## Enqueues batches of increasing size and measures the cost per task of
+## convert_batch() (enqueue) and of running the whole batch (drain): the clock
+## stops when the batch's batch_completed signal arrives. Each task points at a
+## missing source, so it runs the full worker path (pop, start and completion
+## signals, batch result) but fails before any encoding, and the timing isolates
+## the queue and dispatch overhead. Per-task cost should stay flat as the queue
+## grows to 100k entries.
+
+const BATCH_SIZES = [1000, 10000, 100000]
+
+var _completed_usec: Dictionary = {}  # batch_id -> ticks when batch_completed arrived
+
+
+func _init():
+	print("\n" + "=".repeat(60))
+	print("gd-asset-op Task Queue Benchmark")
+	print("=".repeat(60))
+
+	call_deferred("_run_benchmark")
+
+
+func _on_batch_completed(batch_id: int, _results: Array):
+	_completed_usec[batch_id] = Time.get_ticks_usec()
+
+
+func _run_benchmark():
+	var converter = AssetConverter.new()
+	converter.batch_completed.connect(_on_batch_completed)
+	print("Workers: %d" % converter.get_worker_count())
+	print("")
+	print("  %10s %16s %16s" % ["tasks", "enqueue us/task", "drain us/task"])
+	print("-".repeat(60))
+
+	for batch_size in BATCH_SIZES:
+		var tasks: Array[ConversionTask] = []
+		tasks.resize(batch_size)
+		for i in range(batch_size):
+			tasks[i] = ConversionTask.create_audio_to_mp3("/nonexistent/bench_%d.wav" % i, "/nonexistent/bench_%d.mp3" % i)
+
+		var start_usec = Time.get_ticks_usec()
+		var batch_id = converter.convert_batch(tasks)
+		var enqueued_usec = Time.get_ticks_usec()
+
+		# Wait for the batch itself to report completion
+		while not _completed_usec.has(batch_id):
+			await process_frame
+		var drained_usec = _completed_usec[batch_id]
+
+		var enqueue_per_task = float(enqueued_usec - start_usec) / batch_size
+		var drain_per_task = float(drained_usec - enqueued_usec) / batch_size
+		print("  %10d %16.3f %16.3f" % [batch_size, enqueue_per_task, drain_per_task])
+
+	print("=".repeat(60))
+	quit(0)
@@ -25,6 +25,8 @@ func run_all() -> Dictionary:
 		"test_wav_to_mp3_duration_preserved",
 		"test_wav_to_mp3_bitrate_affects_size",
 		"test_wav_to_mp3_progress_signals",
+		"test_wav_to_mp3_parallel_segments",
+		"test_wav_to_mp3_cancel_running",
 		"test_wav_to_mp3_missing_file",
 		"test_wav_to_mp3_wrong_format",
 		# normalize_audio tests
@@ -262,6 +264,126 @@ func test_wav_to_mp3_progress_signals():
 	_clear_task(task_id)
 
 
+func test_wav_to_mp3_parallel_segments():
+	begin_test("WAV to MP3 segment-parallel encoding")
+
+	# Segments are at least 30 seconds, so generate a 65 second mono sine sweep
+	var source = get_output_path("test_long.wav")
+	var output = get_output_path("test_parallel.mp3")
+	var serial_output = get_output_path("test_parallel_serial.mp3")
+	_write_sine_wav(source, 65.0, 44100)
+
+	for path in [output, serial_output]:
+		if FileAccess.file_exists(path):
+			DirAccess.remove_absolute(path)
+
+	var task = ConversionTask.create_audio_to_mp3(source, output, 192, true)
+	var serial_task = ConversionTask.create_audio_to_mp3(source, serial_output, 192, false)
+	var tasks: Array[ConversionTask] = [task, serial_task]
+	_converter.convert_batch(tasks)
+	var task_id = task.id
+	var serial_id = serial_task.id
+	var result = await _wait_for_task(task_id, 120.0)
+	var serial_result = await _wait_for_task(serial_id, 120.0)
+
+	assert_eq(result.error, OK, "conversion should succeed")
+	assert_eq(serial_result.error, OK, "serial conversion should succeed")
+	assert_true(validate_mp3_header(output), "output should have valid MP3 header")
+
+	# Only the segmented path reports its segments, and with two or more encoder
+	# threads a 65 second input is always split in two
+	if AssetConverter.get_max_threads() >= 2:
+		assert_eq(task.segment_count, 2, "input should be split into segments")
+		var segmented_bytes = read_file_bytes(output)
+		var serial_bytes = read_file_bytes(serial_output)
+		assert_ne(segmented_bytes, serial_bytes, "segments are encoded independently, so the stream should differ from the serial one")
+		assert_between(segmented_bytes.size(), serial_bytes.size() * 0.98, serial_bytes.size() * 1.02, "segmenting should not change the bitrate")
+	assert_eq(result.error_message, "", "a successful encode should not report an error message")
+	assert_eq(serial_task.segment_count, 0, "serial encoding should not report segments")
+
+	# First frame carries the Info tag (MPEG-1 mono: after 4 header + 17 side info bytes)
+	var bytes = read_file_bytes(output, 25)
+	assert_eq(bytes.slice(21, 25).get_string_from_ascii(), "Info", "first frame should be the Info tag")
+
+	# Copy to assets dir temporarily to probe (probe only works on res:// paths)
+	var probe_path = get_asset_path("test_parallel_probe.mp3")
+	DirAccess.copy_absolute(output, probe_path)
+	var probe = AssetProbe.probe_audio(probe_path, false)
+	DirAccess.copy_absolute(serial_output, probe_path)
+	var serial_probe = AssetProbe.probe_audio(probe_path, false)
+	DirAccess.remove_absolute(probe_path)
+
+	assert_no_error(probe, "probe should succeed")
+	assert_no_error(serial_probe, "serial probe should succeed")
+	assert_between(probe.duration, 64.9, 65.2, "stitched duration should match the source")
+	assert_between(probe.duration, serial_probe.duration - 0.03, serial_probe.duration + 0.03, "stitched duration should match the serial encode")
+
+	DirAccess.remove_absolute(source)
+	_clear_task(task_id)
+	_clear_task(serial_id)
+
+
+func test_wav_to_mp3_cancel_running():
+	begin_test("WAV to MP3 can be cancelled while encoding")
+
+	var source = get_output_path("test_cancel_long.wav")
+	var output = get_output_path("test_cancel_running.mp3")
+	_write_sine_wav(source, 65.0, 44100)
+
+	if FileAccess.file_exists(output):
+		DirAccess.remove_absolute(output)
+
+	var task_id = _converter.audio_to_mp3(source, output, 320)
+
+	# Wait until the task has been taken by a worker
+	var elapsed = 0.0
+	while not _progress_updates.has(task_id) and not _completed_tasks.has(task_id) and elapsed < 10.0:
+		await Engine.get_main_loop().create_timer(0.01).timeout
+		elapsed += 0.01
+
+	var cancelled = _converter.cancel(task_id)
+	var result = await _wait_for_task(task_id)
+
+	if cancelled:
+		assert_eq(result.error, ERR_SKIP, "cancelled task should report ERR_SKIP")
+		assert_false(FileAccess.file_exists(output), "cancelled task should not write its output")
+	else:
+		# Finished before the cancel arrived
+		assert_eq(result.error, OK, "conversion should succeed")
+
+	DirAccess.remove_absolute(source)
+	_clear_task(task_id)
+
+
+func _write_sine_wav(path: String, seconds: float, sample_rate: int) -> void:
+	var frame_count = int(seconds * sample_rate)
+	var data = PackedByteArray()
+	data.resize(44 + frame_count * 2)
+
+	# RIFF header, 16-bit mono PCM
+	data.encode_u32(0, 0x46464952)  # "RIFF"
+	data.encode_u32(4, 36 + frame_count * 2)
+	data.encode_u32(8, 0x45564157)  # "WAVE"
+	data.encode_u32(12, 0x20746D66)  # "fmt "
+	data.encode_u32(16, 16)
+	data.encode_u16(20, 1)
+	data.encode_u16(22, 1)
+	data.encode_u32(24, sample_rate)
+	data.encode_u32(28, sample_rate * 2)
+	data.encode_u16(32, 2)
+	data.encode_u16(34, 16)
+	data.encode_u32(36, 0x61746164)  # "data"
+	data.encode_u32(40, frame_count * 2)
+
+	for i in range(frame_count):
+		var t = float(i) / sample_rate
+		data.encode_s16(44 + i * 2, int(sin(TAU * (220.0 + 20.0 * t) * t) * 12000.0))
+
+	var file = FileAccess.open(path, FileAccess.WRITE)
+	file.store_buffer(data)
+	file.close()
+
+
 func test_wav_to_mp3_missing_file():
 	begin_test("WAV to MP3 fails for missing file")
 
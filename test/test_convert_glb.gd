@@ -26,6 +26,10 @@ func run_all() -> Dictionary:
 		"test_glb_convert_materials_preserved",
 		"test_glb_convert_texture_count_preserved",
 		"test_glb_convert_progress_signals",
+		"test_glb_convert_batch_shares_textures",
+		"test_glb_convert_basisu_extension",
+		"test_glb_convert_basisu_fallback",
+		"test_glb_convert_texture_roles",
 		"test_glb_convert_missing_file",
 		"test_glb_convert_invalid_file",
 	]
@@ -314,6 +318,251 @@ func test_glb_convert_texture_count_preserved():
 	_clear_task(task_id)
 
 
+# ============================================================
+# Test: Same GLB twice in a batch (textures shared across GLBs)
+# ============================================================
+func test_glb_convert_batch_shares_textures():
+	begin_test("GLB batch reuses identical textures")
+
+	var source = get_asset_path("test.glb")
+	var outputs = [get_output_path("test_glb_shared_a.glb"), get_output_path("test_glb_shared_b.glb")]
+
+	var tasks: Array[ConversionTask] = []
+	for output in outputs:
+		if FileAccess.file_exists(output):
+			DirAccess.remove_absolute(output)
+		tasks.append(ConversionTask.create_glb_textures_to_ktx2(source, output, 128))
+
+	var reused_before = _converter.get_shared_texture_reuse_count()
+	_converter.convert_batch(tasks)
+
+	for task in tasks:
+		var result = await _wait_for_task(task.get_id())
+		assert_eq(result.error, OK, "conversion should succeed")
+
+	# Only one of the two GLBs encodes; the other takes every image from the batch cache
+	var reused = _converter.get_shared_texture_reuse_count() - reused_before
+	assert_gt(reused, 0, "second GLB should be served from the shared texture cache")
+
+	# The cache goes away with the batch, so a GLB converted on its own encodes again
+	var single_output = get_output_path("test_glb_shared_single.glb")
+	var single_id = _converter.glb_textures_to_ktx2(source, single_output, 128)
+	var single = await _wait_for_task(single_id)
+	assert_eq(single.error, OK, "single conversion should succeed")
+	assert_eq(_converter.get_shared_texture_reuse_count() - reused_before, reused, "a task outside the batch should not reuse its textures")
+	_clear_task(single_id)
+
+	# The second GLB takes the textures encoded for the first, so both are identical
+	var bytes_a = FileAccess.get_file_as_bytes(outputs[0])
+	var bytes_b = FileAccess.get_file_as_bytes(outputs[1])
+	assert_gt(bytes_a.size(), 0, "first output should not be empty")
+	assert_eq(bytes_a, bytes_b, "outputs should be byte-identical")
+
+	var probe = AssetProbe.probe_glb(outputs[1])
+	assert_no_error(probe)
+	for i in range(probe.textures.size()):
+		assert_eq(probe.textures[i].mime_type, "image/ktx2", "texture %d should be KTX2 format" % i)
+
+	for task in tasks:
+		_clear_task(task.get_id())
+
+
+# ============================================================
+# Test: Textures reference KTX2 through KHR_texture_basisu
+# ============================================================
+func test_glb_convert_basisu_extension():
+	begin_test("GLB textures use KHR_texture_basisu")
+
+	var source = get_asset_path("test.glb")
+	var output = get_output_path("test_glb_basisu.glb")
+
+	if FileAccess.file_exists(output):
+		DirAccess.remove_absolute(output)
+
+	var task_id = _converter.glb_textures_to_ktx2(source, output, 128)
+	var result = await _wait_for_task(task_id)
+	assert_eq(result.error, OK, "conversion should succeed")
+
+	var json = _read_glb_json(output)
+	assert_true(json.get("extensionsUsed", []).has("KHR_texture_basisu"), "extension should be used")
+	assert_true(json.get("extensionsRequired", []).has("KHR_texture_basisu"), "extension should be required without a fallback")
+
+	for texture in json.get("textures", []):
+		assert_false(texture.has("source"), "texture should not keep a core source")
+		var basisu = texture.get("extensions", {}).get("KHR_texture_basisu", {})
+		assert_has_key(basisu, "source", "texture should reference a KTX2 image")
+		if basisu.has("source"):
+			assert_eq(json.images[int(basisu.source)].mimeType, "image/ktx2", "extension source should be KTX2")
+
+	_clear_task(task_id)
+
+
+# ============================================================
+# Test: PNG fallback kept next to the KTX2 images
+# ============================================================
+func test_glb_convert_basisu_fallback():
+	begin_test("GLB keeps PNG fallback images")
+
+	var source = get_asset_path("test.glb")
+	var output = get_output_path("test_glb_basisu_fallback.glb")
+
+	if FileAccess.file_exists(output):
+		DirAccess.remove_absolute(output)
+
+	var task_id = _converter.glb_textures_to_ktx2(source, output, 128, true, true)
+	var result = await _wait_for_task(task_id)
+	assert_eq(result.error, OK, "conversion should succeed")
+
+	var json = _read_glb_json(output)
+	assert_true(json.get("extensionsUsed", []).has("KHR_texture_basisu"), "extension should be used")
+	assert_false(json.get("extensionsRequired", []).has("KHR_texture_basisu"), "extension should be optional with a fallback")
+
+	for texture in json.get("textures", []):
+		assert_has_key(texture, "source", "texture should keep its fallback source")
+		if texture.has("source"):
+			assert_eq(json.images[int(texture.source)].mimeType, "image/png", "fallback should stay PNG")
+		var basisu = texture.get("extensions", {}).get("KHR_texture_basisu", {})
+		assert_has_key(basisu, "source", "texture should reference a KTX2 image")
+		if basisu.has("source"):
+			assert_eq(json.images[int(basisu.source)].mimeType, "image/ktx2", "extension source should be KTX2")
+
+	# The probe reports the format a KHR_texture_basisu loader would pick
+	var probe = AssetProbe.probe_glb(output)
+	assert_no_error(probe)
+	for tex in probe.textures:
+		assert_eq(tex.mime_type, "image/ktx2", "probe should prefer the KTX2 image")
+		assert_eq(tex.fallback_mime_type, "image/png", "probe should report the fallback")
+
+	_clear_task(task_id)
+
+
+# Parse the JSON chunk of a GLB file
+func _read_glb_json(path: String) -> Dictionary:
+	var bytes = read_file_bytes(path)
+	if bytes.size() < 20:
+		return {}
+	var json_length = bytes.decode_u32(12)
+	var parsed = JSON.parse_string(bytes.slice(20, 20 + json_length).get_string_from_utf8())
+	return parsed if parsed is Dictionary else {}
+
+
+# ============================================================
+# Test: Each image is encoded for its material role
+# ============================================================
+func test_glb_convert_texture_roles():
+	begin_test("GLB images are encoded for their material roles")
+
+	var source = get_output_path("test_glb_roles_source.glb")
+	var output = get_output_path("test_glb_roles.glb")
+	_write_role_glb(source)
+
+	if FileAccess.file_exists(output):
+		DirAccess.remove_absolute(output)
+
+	var task_id = _converter.glb_textures_to_ktx2(source, output, 128)
+	var result = await _wait_for_task(task_id)
+	assert_eq(result.error, OK, "conversion should succeed")
+
+	# Texture index -> expected KTX2 transfer function (see _write_role_glb)
+	var expected = {
+		0: "srgb",    # Base color
+		1: "linear",  # Normal map
+		2: "linear",  # Metallic-roughness, also sampled as occlusion (ORM)
+		3: "linear",  # Occlusion only
+		4: "srgb",    # Base color and metallic-roughness: color wins
+	}
+	var json = _read_glb_json(output)
+	var textures = json.get("textures", [])
+	assert_array_size(textures, expected.size(), "every texture should be kept")
+	for texture_index in expected:
+		if texture_index >= textures.size():
+			continue
+		var basisu = textures[texture_index].get("extensions", {}).get("KHR_texture_basisu", {})
+		assert_has_key(basisu, "source", "texture %d should reference a KTX2 image" % texture_index)
+		if not basisu.has("source"):
+			continue
+		var image_path = get_output_path("test_glb_roles_%d.ktx2" % texture_index)
+		_extract_glb_image(output, json, int(basisu.source), image_path)
+		var probe = AssetProbe.probe_ktx2(image_path)
+		assert_no_error(probe, "texture %d should be a valid KTX2 file" % texture_index)
+		assert_eq(probe.get("transfer_function", ""), expected[texture_index],
+				"texture %d should use the %s transfer function" % [texture_index, expected[texture_index]])
+		# Mipmaps were requested, so every role keeps a mip chain
+		assert_gt(probe.get("mip_levels", 0), 1, "texture %d should have mipmaps" % texture_index)
+		DirAccess.remove_absolute(image_path)
+
+	DirAccess.remove_absolute(source)
+	_clear_task(task_id)
+
+
+# Write a GLB whose five embedded images cover every material role: base color,
+# normal map, ORM (metallic-roughness plus occlusion), occlusion only, and one image
+# sampled both as base color and as metallic-roughness
+func _write_role_glb(path: String):
+	var bin = PackedByteArray()
+	var buffer_views = []
+	var images = []
+	var textures = []
+	for i in range(5):
+		# Distinct payloads, so no image is deduplicated against another
+		var image = Image.create(32, 32, false, Image.FORMAT_RGBA8)
+		for y in range(32):
+			for x in range(32):
+				image.set_pixel(x, y, Color(x / 31.0, y / 31.0, i / 4.0))
+		var png = image.save_png_to_buffer()
+		while bin.size() % 4 != 0:
+			bin.append(0)
+		buffer_views.append({"buffer": 0, "byteOffset": bin.size(), "byteLength": png.size()})
+		bin.append_array(png)
+		images.append({"bufferView": i, "mimeType": "image/png"})
+		textures.append({"source": i})
+	while bin.size() % 4 != 0:
+		bin.append(0)
+
+	var gltf = {
+		"asset": {"version": "2.0", "generator": "gd-asset-op-test"},
+		"materials": [
+			{
+				"pbrMetallicRoughness": {"baseColorTexture": {"index": 0}, "metallicRoughnessTexture": {"index": 2}},
+				"normalTexture": {"index": 1},
+				"occlusionTexture": {"index": 2},
+			},
+			{"occlusionTexture": {"index": 3}},
+			{"pbrMetallicRoughness": {"baseColorTexture": {"index": 4}, "metallicRoughnessTexture": {"index": 4}}},
+		],
+		"textures": textures,
+		"images": images,
+		"bufferViews": buffer_views,
+		"buffers": [{"byteLength": bin.size()}],
+	}
+	var json_bytes = JSON.stringify(gltf).to_utf8_buffer()
+	while json_bytes.size() % 4 != 0:
+		json_bytes.append(0x20)
+
+	var file = FileAccess.open(path, FileAccess.WRITE)
+	file.store_32(0x46546C67)  # "glTF"
+	file.store_32(2)
+	file.store_32(12 + 8 + json_bytes.size() + 8 + bin.size())
+	file.store_32(json_bytes.size())
+	file.store_32(0x4E4F534A)  # "JSON"
+	file.store_buffer(json_bytes)
+	file.store_32(bin.size())
+	file.store_32(0x004E4942)  # "BIN\0"
+	file.store_buffer(bin)
+	file.close()
+
+
+# Copy one embedded image of a GLB to its own file
+func _extract_glb_image(glb_path: String, json: Dictionary, image_index: int, out_path: String):
+	var bytes = read_file_bytes(glb_path)
+	var bin_start = 20 + bytes.decode_u32(12) + 8
+	var view = json.bufferViews[int(json.images[image_index].bufferView)]
+	var offset = bin_start + int(view.get("byteOffset", 0))
+	var file = FileAccess.open(out_path, FileAccess.WRITE)
+	file.store_buffer(bytes.slice(offset, offset + int(view.byteLength)))
+	file.close()
+
+
 # ============================================================
 # Test: Progress signals emitted correctly
 # ============================================================
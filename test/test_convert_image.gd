@@ -25,14 +25,33 @@ func run_all() -> Dictionary:
 		"test_convert_png_mipmaps_generated",
 		"test_convert_png_no_mipmaps",
 		"test_convert_png_quality_affects_size",
+		"test_convert_png_etc1s",
+		"test_convert_png_downscale",
+		"test_convert_hdr_basic",
+		"test_convert_cubemap",
+		"test_convert_2d_array",
+		"test_convert_cubemap_array",
+		"test_convert_volume",
+		"test_convert_array_size_mismatch",
 		"test_convert_jpeg_basic",
 		"test_convert_jpeg_dimensions_preserved",
 		"test_convert_progress_signals",
 		"test_convert_progress_monotonic",
+		"test_convert_batch_progress",
+		"test_convert_concurrent_batches",
+		"test_convert_batch_longest_first",
+		"test_convert_interactive_priority",
+		"test_convert_background_aging",
+		"test_convert_background_aging_stolen",
+		"test_convert_resize_workers_while_running",
 		"test_convert_task_id_unique",
 		"test_convert_missing_file",
 		"test_convert_invalid_output_path",
 		"test_convert_cancel_task",
+		"test_convert_cancel_just_queued",
+		"test_convert_cache_hit",
+		"test_convert_incremental_skips_unchanged",
+		"test_convert_incremental_batch_skips_queue",
 	]
 
 	for test_name in tests:
@@ -290,6 +309,247 @@ func test_convert_png_quality_affects_size():
 	_clear_task(task_id_high)
 
 
+# ============================================================
+# Test: ETC1S encoder produces BasisLZ output
+# ============================================================
+func test_convert_png_etc1s():
+	begin_test("PNG to KTX2 with the ETC1S encoder")
+
+	var source = get_asset_path("test.png")
+	var output_uastc = get_output_path("test_encoder_uastc.ktx2")
+	var output_etc1s = get_output_path("test_encoder_etc1s.ktx2")
+
+	for output in [output_uastc, output_etc1s]:
+		if FileAccess.file_exists(output):
+			DirAccess.remove_absolute(output)
+
+	var task_id_uastc = _converter.image_to_ktx2(source, output_uastc, 128, true, ConversionTask.ENCODER_UASTC)
+	var result_uastc = await _wait_for_task(task_id_uastc)
+	assert_eq(result_uastc.error, OK, "UASTC conversion should succeed")
+
+	var task_id_etc1s = _converter.image_to_ktx2(source, output_etc1s, 128, true, ConversionTask.ENCODER_ETC1S, 2)
+	var result_etc1s = await _wait_for_task(task_id_etc1s)
+	assert_eq(result_etc1s.error, OK, "ETC1S conversion should succeed")
+
+	var probe_uastc = AssetProbe.probe_ktx2(output_uastc)
+	var probe_etc1s = AssetProbe.probe_ktx2(output_etc1s)
+	assert_no_error(probe_uastc)
+	assert_no_error(probe_etc1s)
+
+	assert_eq(probe_uastc.compression_scheme, "zstd", "UASTC output should use Zstandard")
+	assert_eq(probe_etc1s.compression_scheme, "basis_lz", "ETC1S output should use BasisLZ")
+	assert_eq(probe_etc1s.width, probe_uastc.width, "dimensions should match")
+	assert_eq(probe_etc1s.height, probe_uastc.height, "dimensions should match")
+	assert_lt(probe_etc1s.size_bytes, probe_uastc.size_bytes, "ETC1S output should be smaller")
+
+	_clear_task(task_id_uastc)
+	_clear_task(task_id_etc1s)
+
+
+# ============================================================
+# Test: Downscale before encoding
+# ============================================================
+func test_convert_png_downscale():
+	begin_test("PNG to KTX2 with max_size, scale and pow2")
+
+	var source = get_asset_path("test.png")  # 256x256
+	var output_scaled = get_output_path("test_downscale_scale.ktx2")
+	var output_clamped = get_output_path("test_downscale_max_size.ktx2")
+	var output_no_upscale = get_output_path("test_downscale_no_upscale.ktx2")
+
+	for output in [output_scaled, output_clamped, output_no_upscale]:
+		if FileAccess.file_exists(output):
+			DirAccess.remove_absolute(output)
+
+	var task_id_scaled = _converter.image_to_ktx2(source, output_scaled, 128, true, ConversionTask.ENCODER_UASTC, 2, 0, 0.5)
+	var result_scaled = await _wait_for_task(task_id_scaled)
+	assert_eq(result_scaled.error, OK, "scaled conversion should succeed")
+
+	# 256 clamped to 100 rounds to 128, which is above max_size, so 64
+	var task_id_clamped = _converter.image_to_ktx2(source, output_clamped, 128, true, ConversionTask.ENCODER_UASTC, 2, 100, 1.0, true)
+	var result_clamped = await _wait_for_task(task_id_clamped)
+	assert_eq(result_clamped.error, OK, "clamped conversion should succeed")
+
+	# 600x400: scale 2 does not enlarge, and 400 rounds down to 256 rather than up past the source
+	var task_id_no_upscale = _converter.image_to_ktx2(get_asset_path("test.jpg"), output_no_upscale, 128, false,
+			ConversionTask.ENCODER_UASTC, 2, 0, 2.0, true)
+	var result_no_upscale = await _wait_for_task(task_id_no_upscale)
+	assert_eq(result_no_upscale.error, OK, "conversion with scale above 1 should succeed")
+
+	var probe_scaled = AssetProbe.probe_ktx2(output_scaled)
+	assert_no_error(probe_scaled)
+	assert_eq(probe_scaled.width, 128, "scale 0.5 should halve the width")
+	assert_eq(probe_scaled.height, 128, "scale 0.5 should halve the height")
+
+	var probe_clamped = AssetProbe.probe_ktx2(output_clamped)
+	assert_no_error(probe_clamped)
+	assert_eq(probe_clamped.width, 64, "width should be clamped and rounded to a power of two")
+	assert_eq(probe_clamped.height, 64, "height should be clamped and rounded to a power of two")
+
+	var probe_no_upscale = AssetProbe.probe_ktx2(output_no_upscale)
+	assert_no_error(probe_no_upscale)
+	assert_eq(probe_no_upscale.width, 512, "width should round to a power of two below the source")
+	assert_eq(probe_no_upscale.height, 256, "height should round down rather than exceed the source")
+
+	_clear_task(task_id_scaled)
+	_clear_task(task_id_clamped)
+	_clear_task(task_id_no_upscale)
+
+
+# ============================================================
+# Test: Radiance HDR conversion
+# ============================================================
+func test_convert_hdr_basic():
+	begin_test("Radiance HDR to UASTC HDR and ASTC HDR KTX2")
+
+	# 16x16 uncompressed RGBE image with values above 1.0
+	var source = get_output_path("test_hdr_source.hdr")
+	var file = FileAccess.open(source, FileAccess.WRITE)
+	file.store_buffer("#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y 16 +X 16\n".to_utf8_buffer())
+	for y in range(16):
+		for x in range(16):
+			file.store_buffer(PackedByteArray([128 + x * 7, 64 + y * 11, 200, 130]))
+	file.close()
+
+	var output_4x4 = get_output_path("test_hdr_4x4.ktx2")
+	var output_6x6 = get_output_path("test_hdr_6x6.ktx2")
+	for output in [output_4x4, output_6x6]:
+		if FileAccess.file_exists(output):
+			DirAccess.remove_absolute(output)
+
+	# HDR sources pick UASTC HDR 4x4 even with the default encoder
+	var task_id_4x4 = _converter.image_to_ktx2(source, output_4x4)
+	var result_4x4 = await _wait_for_task(task_id_4x4)
+	assert_eq(result_4x4.error, OK, "UASTC HDR conversion should succeed")
+
+	var task_id_6x6 = _converter.image_to_ktx2(source, output_6x6, 128, true, ConversionTask.ENCODER_ASTC_HDR_6X6)
+	var result_6x6 = await _wait_for_task(task_id_6x6)
+	assert_eq(result_6x6.error, OK, "ASTC HDR 6x6 conversion should succeed")
+
+	for output in [output_4x4, output_6x6]:
+		assert_true(validate_ktx2_header(output), "output should be KTX2")
+		var probe = AssetProbe.probe_ktx2(output)
+		assert_no_error(probe)
+		assert_eq(probe.width, 16, "width should be preserved")
+		assert_eq(probe.height, 16, "height should be preserved")
+		assert_eq(probe.compression_scheme, "zstd", "HDR output should use Zstandard")
+
+	_clear_task(task_id_4x4)
+	_clear_task(task_id_6x6)
+
+
+# ============================================================
+# Test: Cubemap assembly
+# ============================================================
+func test_convert_cubemap():
+	begin_test("Six images to a cubemap KTX2")
+
+	var face = get_asset_path("test.png")
+	var output = get_output_path("test_cubemap.ktx2")
+	if FileAccess.file_exists(output):
+		DirAccess.remove_absolute(output)
+
+	var faces = PackedStringArray([face, face, face, face, face, face])
+	var task_id = _converter.images_to_ktx2(faces, output, ConversionTask.LAYOUT_CUBEMAP)
+	var result = await _wait_for_task(task_id)
+	assert_eq(result.error, OK, "cubemap conversion should succeed")
+
+	var probe = AssetProbe.probe_ktx2(output)
+	assert_no_error(probe)
+	assert_true(probe.is_cubemap, "output should be a cubemap")
+	assert_eq(probe.width, 256, "face width should be preserved")
+	assert_eq(probe.height, 256, "face height should be preserved")
+
+	_clear_task(task_id)
+
+
+# ============================================================
+# Test: Images to a 2D array
+# ============================================================
+func test_convert_2d_array():
+	begin_test("Three images to a 2D array KTX2")
+
+	var layer = get_asset_path("test.png")
+	var output = get_output_path("test_array.ktx2")
+	if FileAccess.file_exists(output):
+		DirAccess.remove_absolute(output)
+
+	var task_id = _converter.images_to_ktx2(PackedStringArray([layer, layer, layer]), output, ConversionTask.LAYOUT_2D_ARRAY)
+	var result = await _wait_for_task(task_id)
+	assert_eq(result.error, OK, "array conversion should succeed")
+
+	var probe = AssetProbe.probe_ktx2(output)
+	assert_no_error(probe)
+	assert_eq(probe.layers, 3, "each image should be one layer")
+	assert_eq(probe.depth, 1, "an array should not have depth")
+	assert_false(probe.is_cubemap, "an array should not be a cubemap")
+
+	_clear_task(task_id)
+
+
+# ============================================================
+# Test: Twelve faces to a cubemap array
+# ============================================================
+func test_convert_cubemap_array():
+	begin_test("Twelve images to a cubemap array KTX2")
+
+	var face = get_asset_path("test.png")
+	var output = get_output_path("test_cubemap_array.ktx2")
+	if FileAccess.file_exists(output):
+		DirAccess.remove_absolute(output)
+
+	var faces = PackedStringArray()
+	for i in range(12):
+		faces.append(face)
+	var task_id = _converter.images_to_ktx2(faces, output, ConversionTask.LAYOUT_CUBEMAP)
+	var result = await _wait_for_task(task_id)
+	assert_eq(result.error, OK, "cubemap array conversion should succeed")
+
+	var probe = AssetProbe.probe_ktx2(output)
+	assert_no_error(probe)
+	assert_true(probe.is_cubemap, "output should be a cubemap")
+	assert_eq(probe.layers, 2, "every six faces should make one layer")
+	assert_eq(probe.depth, 1, "a cubemap array should not have depth")
+
+	_clear_task(task_id)
+
+
+# ============================================================
+# Test: Volume layout is rejected
+# ============================================================
+func test_convert_volume():
+	begin_test("Volume layout is rejected")
+
+	var slice = get_asset_path("test.png")
+	var output = get_output_path("test_volume.ktx2")
+	if FileAccess.file_exists(output):
+		DirAccess.remove_absolute(output)
+
+	# Basis Universal cannot produce a 3D KTX2 that its own transcoder accepts
+	var task_id = _converter.images_to_ktx2(PackedStringArray([slice, slice, slice, slice]), output, ConversionTask.LAYOUT_VOLUME)
+	var result = await _wait_for_task(task_id)
+	assert_eq(result.error, ERR_UNAVAILABLE, "volume conversion should be rejected")
+	assert_false(FileAccess.file_exists(output), "no output should be written")
+
+	_clear_task(task_id)
+
+
+# ============================================================
+# Test: Array layers must share one size
+# ============================================================
+func test_convert_array_size_mismatch():
+	begin_test("Texture array with mismatched layer sizes fails")
+
+	var output = get_output_path("test_array_mismatch.ktx2")
+	var layers = PackedStringArray([get_asset_path("test.png"), get_asset_path("test_0.png")])
+	var task_id = _converter.images_to_ktx2(layers, output, ConversionTask.LAYOUT_2D_ARRAY)
+	var result = await _wait_for_task(task_id)
+	assert_ne(result.error, OK, "mismatched layers should fail")
+	assert_string_contains(result.error_message, "size differs", "error should name the size mismatch")
+
+	_clear_task(task_id)
+
+
 # ============================================================
 # Test: JPEG basic conversion
 # ============================================================
@@ -373,10 +633,6 @@ func test_convert_progress_signals():
 			assert_gte(updates[i], 0.0, "progress[%d] must be >= 0" % i)
 			assert_lte(updates[i], 1.0, "progress[%d] must be <= 1" % i)
 
-		# First progress should be 0 or close to it
-		if updates.size() > 0:
-			assert_lte(updates[0], 0.5, "first progress should be low")
-
 		# Last progress must be exactly 1.0
 		if updates.size() > 0:
 			assert_eq(updates[-1], 1.0, "final progress must be exactly 1.0")
@@ -411,6 +667,331 @@ func test_convert_progress_monotonic():
 	_clear_task(task_id)
 
 
+# ============================================================
+# Test: batch_progress reports totals for a batch
+# ============================================================
+func test_convert_batch_progress():
+	begin_test("batch_progress reports done/total and bytes")
+
+	var source = get_asset_path("test.png")
+	var reports: Array = []
+	var on_batch_progress = func(batch_id: int, done: int, total: int, bytes_in: int, bytes_out: int, eta: float):
+		reports.append({"batch_id": batch_id, "done": done, "total": total, "bytes_in": bytes_in, "bytes_out": bytes_out, "eta": eta})
+	var completed: Dictionary = {}  # batch_id -> results
+	var on_batch_completed = func(batch_id: int, results: Array):
+		completed[batch_id] = results
+	_converter.batch_progress.connect(on_batch_progress)
+	_converter.batch_completed.connect(on_batch_completed)
+
+	var tasks: Array[ConversionTask] = []
+	for i in range(3):
+		tasks.append(ConversionTask.create_image_to_ktx2(source, get_output_path("batch_progress_%d.ktx2" % i), 64, false))
+	var batch_id = _converter.convert_batch(tasks)
+
+	# The final report is delivered just before batch_completed
+	var elapsed = 0.0
+	while not completed.has(batch_id) and elapsed < 30.0:
+		await Engine.get_main_loop().create_timer(0.1).timeout
+		elapsed += 0.1
+
+	_converter.batch_progress.disconnect(on_batch_progress)
+	_converter.batch_completed.disconnect(on_batch_completed)
+
+	assert_array_not_empty(reports, "should emit batch_progress")
+	if reports.size() > 0:
+		var last = reports[-1]
+		assert_eq(last.batch_id, batch_id, "should report the batch ID")
+		assert_eq(last.total, 3, "total should count the batch's tasks")
+		assert_eq(last.done, last.total, "final report should have every task done")
+		assert_gt(last.bytes_in, 0, "should count source bytes")
+		assert_gt(last.bytes_out, 0, "should count output bytes")
+		for i in range(1, reports.size()):
+			assert_gte(reports[i].done, reports[i - 1].done, "done should not go backwards")
+
+	for task in tasks:
+		_clear_task(task.id)
+
+
+# ============================================================
+# Test: Concurrent batches complete independently
+# ============================================================
+func test_convert_concurrent_batches():
+	begin_test("concurrent batches report their own results")
+
+	var source = get_asset_path("test.png")
+	var completed: Dictionary = {}  # batch_id -> results
+	var on_batch_completed = func(batch_id: int, results: Array):
+		completed[batch_id] = results
+	var last_progress: Dictionary = {}  # batch_id -> last batch_progress report
+	var on_batch_progress = func(batch_id: int, done: int, total: int, bytes_in: int, bytes_out: int, _eta: float):
+		last_progress[batch_id] = {"done": done, "total": total, "bytes_in": bytes_in, "bytes_out": bytes_out}
+	_converter.batch_completed.connect(on_batch_completed)
+	_converter.batch_progress.connect(on_batch_progress)
+
+	var tasks_a: Array[ConversionTask] = [
+		ConversionTask.create_image_to_ktx2(source, get_output_path("batch_a_0.ktx2"), 64, false),
+	]
+	var tasks_b: Array[ConversionTask] = [
+		ConversionTask.create_image_to_ktx2(source, get_output_path("batch_b_0.ktx2"), 64, false),
+		ConversionTask.create_image_to_ktx2(source, get_output_path("batch_b_1.ktx2"), 64, false),
+	]
+	var batch_a = _converter.convert_batch(tasks_a)
+	var batch_b = _converter.convert_batch(tasks_b)
+	assert_ne(batch_a, batch_b, "batch IDs should differ")
+	assert_eq(tasks_b[0].batch_id, batch_b, "tasks should carry their batch ID")
+
+	var elapsed = 0.0
+	while (not completed.has(batch_a) or not completed.has(batch_b)) and elapsed < 30.0:
+		await Engine.get_main_loop().create_timer(0.1).timeout
+		elapsed += 0.1
+
+	_converter.batch_completed.disconnect(on_batch_completed)
+	_converter.batch_progress.disconnect(on_batch_progress)
+
+	assert_true(completed.has(batch_a), "first batch should complete")
+	assert_true(completed.has(batch_b), "second batch should complete")
+	if completed.has(batch_a) and completed.has(batch_b):
+		assert_array_size(completed[batch_a], 1, "first batch should hold only its own result")
+		assert_array_size(completed[batch_b], 2, "second batch should hold only its own results")
+		assert_eq(completed[batch_a][0].task_id, tasks_a[0].id, "result should belong to the first batch")
+
+	# Each batch reports its own totals, not those of everything queued
+	assert_true(last_progress.has(batch_a), "first batch should report progress")
+	assert_true(last_progress.has(batch_b), "second batch should report progress")
+	if last_progress.has(batch_a) and last_progress.has(batch_b):
+		assert_eq(last_progress[batch_a].total, 1, "first batch total should count its own task")
+		assert_eq(last_progress[batch_a].done, 1, "first batch should finish its task")
+		assert_eq(last_progress[batch_b].total, 2, "second batch total should count its own tasks")
+		assert_eq(last_progress[batch_b].done, 2, "second batch should finish its tasks")
+		assert_eq(last_progress[batch_b].bytes_in, last_progress[batch_a].bytes_in * 2,
+				"second batch should read two sources")
+
+	for task in tasks_a + tasks_b:
+		_clear_task(task.id)
+
+
+# ============================================================
+# Test: Batches are estimated before queueing and run longest first
+# ============================================================
+func test_convert_batch_longest_first():
+	begin_test("convert_batch orders tasks by header-based estimated cost")
+
+	var started: Array = []
+	var on_started = func(task_id: int, _source_path: String):
+		started.append(task_id)
+	_converter.conversion_started.connect(on_started)
+
+	# One worker, so tasks start in queue order
+	var previous_workers = _converter.get_worker_count()
+	var previous_policy = _converter.get_scheduling_policy()
+	_converter.set_worker_count(1)
+	_converter.set_scheduling_policy(AssetConverter.SCHEDULE_LONGEST_FIRST)
+
+	# test.png is 256x256 (0.07 MP), test.jpg is 600x400 (0.24 MP)
+	var small = ConversionTask.create_image_to_ktx2(get_asset_path("test.png"), get_output_path("order_small.ktx2"), 64, false)
+	var large = ConversionTask.create_image_to_ktx2(get_asset_path("test.jpg"), get_output_path("order_large.ktx2"), 64, false)
+	var tasks: Array[ConversionTask] = [small, large]
+	_converter.convert_batch(tasks)
+
+	# Set before any worker has taken the tasks
+	assert_gt(small.estimated_cost, 0.0, "small task should be estimated when queued")
+	assert_gt(large.estimated_cost, small.estimated_cost, "more pixels should cost more")
+
+	await _wait_for_task(small.id)
+	await _wait_for_task(large.id)
+
+	_converter.conversion_started.disconnect(on_started)
+	_converter.set_worker_count(previous_workers)
+	_converter.set_scheduling_policy(previous_policy)
+
+	assert_lt(started.find(large.id), started.find(small.id), "larger task should start first")
+
+	_clear_task(small.id)
+	_clear_task(large.id)
+
+
+# ============================================================
+# Test: Interactive tasks start before queued background tasks
+# ============================================================
+func test_convert_interactive_priority():
+	begin_test("interactive task preempts queued background tasks")
+
+	var source = get_asset_path("test.png")
+	var started: Array = []
+	var on_started = func(task_id: int, _source_path: String):
+		started.append(task_id)
+	_converter.conversion_started.connect(on_started)
+
+	# One worker, so everything after the first background task has to wait in the queue
+	var previous_workers = _converter.get_worker_count()
+	_converter.set_worker_count(1)
+	_converter.reset_queue_wait_stats()
+
+	var background_ids = []
+	for i in range(4):
+		background_ids.append(_converter.image_to_ktx2(source, get_output_path("priority_bg_%d.ktx2" % i), 128, true,
+				ConversionTask.ENCODER_UASTC, 2, 0, 1.0, false, ConversionTask.PRIORITY_BACKGROUND))
+	var interactive_id = _converter.image_to_ktx2(source, get_output_path("priority_interactive.ktx2"), 64, false,
+			ConversionTask.ENCODER_UASTC, 2, 0, 1.0, false, ConversionTask.PRIORITY_INTERACTIVE)
+
+	var result = await _wait_for_task(interactive_id)
+	for task_id in background_ids:
+		await _wait_for_task(task_id)
+
+	_converter.conversion_started.disconnect(on_started)
+	_converter.set_worker_count(previous_workers)
+
+	assert_eq(result.error, OK, "interactive conversion should succeed")
+	assert_lte(started.find(interactive_id), 1, "interactive task should start no later than second")
+
+	var stats = _converter.get_queue_wait_stats()
+	assert_true(stats.has(ConversionTask.PRIORITY_INTERACTIVE), "should report the interactive lane")
+	assert_eq(stats[ConversionTask.PRIORITY_INTERACTIVE].tasks, 1, "one interactive task should have waited")
+	assert_eq(stats[ConversionTask.PRIORITY_BACKGROUND].tasks, 4, "four background tasks should have waited")
+	assert_gte(stats[ConversionTask.PRIORITY_BACKGROUND].max_wait, stats[ConversionTask.PRIORITY_INTERACTIVE].max_wait,
+			"background tasks should wait at least as long")
+
+	_clear_task(interactive_id)
+	for task_id in background_ids:
+		_clear_task(task_id)
+
+
+# ============================================================
+# Test: A waiting background task ages past a stream of normal tasks
+# ============================================================
+func test_convert_background_aging():
+	begin_test("background task is not starved by newer normal tasks")
+
+	var source = get_asset_path("test.jpg")
+	var started: Array = []
+	var on_started = func(task_id: int, _source_path: String):
+		started.append(task_id)
+	_converter.conversion_started.connect(on_started)
+
+	# One worker kept busy with normal tasks; the background task only runs once it
+	# has aged ahead of the normal tasks queued after it
+	var previous_workers = _converter.get_worker_count()
+	_converter.set_worker_count(1)
+
+	var normal_ids = []
+	for i in range(4):
+		normal_ids.append(_converter.image_to_ktx2(source, get_output_path("aging_normal_%d.ktx2" % (normal_ids.size() % 8))))
+	var background_id = _converter.image_to_ktx2(source, get_output_path("aging_background.ktx2"), 64, false,
+			ConversionTask.ENCODER_UASTC, 2, 0, 1.0, false, ConversionTask.PRIORITY_BACKGROUND)
+
+	# Keep normal tasks queued for longer than the aging interval
+	var elapsed = 0.0
+	while elapsed < 8.0:
+		while _converter.get_pending_count() < 4:
+			normal_ids.append(_converter.image_to_ktx2(source, get_output_path("aging_normal_%d.ktx2" % (normal_ids.size() % 8))))
+		await Engine.get_main_loop().create_timer(0.05).timeout
+		elapsed += 0.05
+	var started_during_stream = started.has(background_id)
+	var last_normal_id = normal_ids[-1]
+
+	var result = await _wait_for_task(background_id)
+	for task_id in normal_ids:
+		await _wait_for_task(task_id)
+
+	_converter.conversion_started.disconnect(on_started)
+	_converter.set_worker_count(previous_workers)
+
+	assert_eq(result.error, OK, "background conversion should succeed")
+	assert_true(started_during_stream, "background task should start while normal tasks are still queued")
+	assert_lte(started.find(background_id), started.find(last_normal_id),
+			"background task should start before the newest normal task")
+
+	_clear_task(background_id)
+	for task_id in normal_ids:
+		_clear_task(task_id)
+
+
+# ============================================================
+# Test: An aged task is stolen from a deque its worker no longer serves
+# ============================================================
+func test_convert_background_aging_stolen():
+	begin_test("background task on another worker's deque is not starved")
+
+	var source = get_asset_path("test.jpg")
+	var started: Array = []
+	var on_started = func(task_id: int, _source_path: String):
+		started.append(task_id)
+	_converter.conversion_started.connect(on_started)
+
+	# Two workers, each with queued normal tasks and one background task in its deque
+	var previous_workers = _converter.get_worker_count()
+	_converter.set_worker_count(2)
+	var normal_ids = []
+	for i in range(8):
+		normal_ids.append(_converter.image_to_ktx2(source, get_output_path("stolen_normal_%d.ktx2" % (normal_ids.size() % 8))))
+	var background_ids = []
+	for i in range(2):
+		background_ids.append(_converter.image_to_ktx2(source, get_output_path("stolen_background_%d.ktx2" % i), 64, false,
+				ConversionTask.ENCODER_UASTC, 2, 0, 1.0, false, ConversionTask.PRIORITY_BACKGROUND))
+
+	# The second worker retires, so its deque is only drained by stealing while the
+	# remaining worker always has newer normal work of its own
+	_converter.set_worker_count(1)
+	var elapsed = 0.0
+	while elapsed < 10.0:
+		while _converter.get_pending_count() < 4:
+			normal_ids.append(_converter.image_to_ktx2(source, get_output_path("stolen_normal_%d.ktx2" % (normal_ids.size() % 8))))
+		await Engine.get_main_loop().create_timer(0.05).timeout
+		elapsed += 0.05
+	var started_during_stream = background_ids.all(func(task_id): return started.has(task_id))
+
+	var background_results = []
+	for task_id in background_ids:
+		background_results.append(await _wait_for_task(task_id))
+	for task_id in normal_ids:
+		await _wait_for_task(task_id)
+
+	_converter.conversion_started.disconnect(on_started)
+	_converter.set_worker_count(previous_workers)
+
+	assert_true(started_during_stream, "both background tasks should start while normal tasks are still queued")
+	for result in background_results:
+		assert_eq(result.error, OK, "background conversion should succeed")
+
+	for task_id in background_ids + normal_ids:
+		_clear_task(task_id)
+
+
+# ============================================================
+# Test: Resizing the worker pool does not wait for running tasks
+# ============================================================
+func test_convert_resize_workers_while_running():
+	begin_test("set_worker_count returns without waiting for running tasks")
+
+	var source = get_asset_path("test.png")
+	var previous_workers = _converter.get_worker_count()
+
+	var task_ids = []
+	for i in range(4):
+		task_ids.append(_converter.image_to_ktx2(source, get_output_path("resize_workers_%d.ktx2" % i), 255, true))
+
+	var start_usec = Time.get_ticks_usec()
+	_converter.set_worker_count(1)
+	var shrink_usec = Time.get_ticks_usec() - start_usec
+	assert_eq(_converter.get_worker_count(), 1, "worker count should change immediately")
+	assert_lt(shrink_usec, 50000, "shrinking should not wait for running encodes")
+
+	# Every queued task still runs on the remaining worker
+	for task_id in task_ids:
+		var result = await _wait_for_task(task_id, 60.0)
+		assert_eq(result.error, OK, "task %d should complete" % task_id)
+
+	_converter.set_worker_count(previous_workers)
+	assert_eq(_converter.get_worker_count(), previous_workers, "pool should grow back")
+
+	var task_id = _converter.image_to_ktx2(source, get_output_path("resize_workers_after.ktx2"), 64, false)
+	var after = await _wait_for_task(task_id)
+	assert_eq(after.error, OK, "regrown pool should run tasks")
+
+	for id in task_ids + [task_id]:
+		_clear_task(id)
+
+
 # ============================================================
 # Test: Task IDs are unique
 # ============================================================
@@ -502,3 +1083,154 @@ func test_convert_cancel_task():
 	assert_true(cancelled or _completed_tasks.has(task_id), "should cancel or complete")
 
 	_clear_task(task_id)
+
+
+# ============================================================
+# Test: Cancelling right after queueing always reaches the task
+# ============================================================
+func test_convert_cancel_just_queued():
+	begin_test("cancel finds a task while a worker is taking it")
+
+	var source = get_asset_path("test.png")
+
+	# Workers are idle, so each task is taken the moment it is queued and cancel()
+	# runs while the worker claims it
+	var task_ids = []
+	for i in range(16):
+		var task_id = _converter.image_to_ktx2(source, get_output_path("cancel_queued_%d.ktx2" % i), 255, true)
+		task_ids.append(task_id)
+		assert_true(_converter.cancel(task_id), "cancel should find task %d" % task_id)
+
+	var elapsed = 0.0
+	while _converter.is_running() and elapsed < 30.0:
+		await Engine.get_main_loop().create_timer(0.1).timeout
+		elapsed += 0.1
+	assert_false(_converter.is_running(), "cancelled tasks should all finish")
+
+	for task_id in task_ids:
+		_clear_task(task_id)
+
+
+# ============================================================
+# Test: Conversion cache reuses outputs for unchanged sources
+# ============================================================
+func test_convert_cache_hit():
+	begin_test("Conversion cache hit skips re-encoding")
+
+	var converter = AssetConverter.new()
+	converter.conversion_completed.connect(_on_completed)
+
+	var cache_dir = get_output_path("cache")
+	if DirAccess.dir_exists_absolute(cache_dir):
+		for file_name in DirAccess.get_files_at(cache_dir):
+			DirAccess.remove_absolute(cache_dir + "/" + file_name)
+	converter.cache_directory = cache_dir
+
+	var source = get_asset_path("test.png")
+	var output_first = get_output_path("test_cache_first.ktx2")
+	var output_second = get_output_path("test_cache_second.ktx2")
+
+	var first_id = converter.image_to_ktx2(source, output_first, 128, true)
+	var first = await _wait_for_task(first_id)
+	assert_eq(first.error, OK, "first conversion should succeed")
+	assert_eq(converter.get_cache_miss_count(), 1, "first conversion should miss")
+
+	var second_id = converter.image_to_ktx2(source, output_second, 128, true)
+	var second = await _wait_for_task(second_id)
+	assert_eq(second.error, OK, "second conversion should succeed")
+	assert_eq(converter.get_cache_hit_count(), 1, "second conversion should hit")
+	assert_eq(read_file_bytes(output_second), read_file_bytes(output_first), "cached output should be identical")
+
+	# Different options must not share an entry
+	var third_id = converter.image_to_ktx2(source, get_output_path("test_cache_third.ktx2"), 64, true)
+	await _wait_for_task(third_id)
+	assert_eq(converter.get_cache_miss_count(), 2, "different quality should miss")
+
+	_clear_task(first_id)
+	_clear_task(second_id)
+	_clear_task(third_id)
+
+
+# ============================================================
+# Test: Incremental mode skips unchanged outputs
+# ============================================================
+func test_convert_incremental_skips_unchanged():
+	begin_test("Incremental mode skips up-to-date outputs")
+
+	var converter = AssetConverter.new()
+	converter.conversion_completed.connect(_on_completed)
+	converter.incremental = true
+
+	var source = get_asset_path("test.png")
+	var output = get_output_path("test_incremental.ktx2")
+	if FileAccess.file_exists(output):
+		DirAccess.remove_absolute(output)
+
+	var first_id = converter.image_to_ktx2(source, output, 128, true)
+	var first = await _wait_for_task(first_id)
+	assert_eq(first.error, OK, "first conversion should succeed")
+	assert_ne(first.error_message, "Output is up to date", "first conversion should encode")
+
+	var second_id = converter.image_to_ktx2(source, output, 128, true)
+	var second = await _wait_for_task(second_id)
+	assert_eq(second.error, OK, "second conversion should succeed")
+	assert_eq(second.error_message, "Output is up to date", "unchanged task should be skipped")
+
+	# Changed options must convert again
+	var third_id = converter.image_to_ktx2(source, output, 64, true)
+	var third = await _wait_for_task(third_id)
+	assert_eq(third.error, OK, "third conversion should succeed")
+	assert_ne(third.error_message, "Output is up to date", "changed quality should encode")
+
+	_clear_task(first_id)
+	_clear_task(second_id)
+	_clear_task(third_id)
+
+
+# ============================================================
+# Test: Up-to-date batch tasks never reach the queue
+# ============================================================
+func test_convert_incremental_batch_skips_queue():
+	begin_test("Incremental batch completes unchanged tasks without queueing")
+
+	var converter = AssetConverter.new()
+	converter.incremental = true
+	var started: Array = []
+	var completed: Dictionary = {}  # batch_id -> results
+	converter.conversion_started.connect(func(task_id: int, _source_path: String): started.append(task_id))
+	converter.batch_completed.connect(func(batch_id: int, results: Array): completed[batch_id] = results)
+
+	var source = get_asset_path("test.png")
+	var output = get_output_path("test_incremental_batch.ktx2")
+	if FileAccess.file_exists(output):
+		DirAccess.remove_absolute(output)
+
+	var first_tasks: Array[ConversionTask] = [ConversionTask.create_image_to_ktx2(source, output, 128, true)]
+	var first_batch = converter.convert_batch(first_tasks)
+	var elapsed = 0.0
+	while not completed.has(first_batch) and elapsed < 30.0:
+		await Engine.get_main_loop().create_timer(0.1).timeout
+		elapsed += 0.1
+	assert_true(completed.has(first_batch), "first batch should complete")
+	assert_true(started.has(first_tasks[0].id), "first task should run on a worker")
+
+	# Same options filled in another order must still match the manifest entry
+	var second_task = ConversionTask.create_image_to_ktx2(source, output, 128, true)
+	var options = second_task.options
+	var quality = options["quality"]
+	options.erase("quality")
+	options["quality"] = quality
+	var second_tasks: Array[ConversionTask] = [second_task]
+	var second_batch = converter.convert_batch(second_tasks)
+	assert_eq(converter.get_pending_count(), 0, "up-to-date task should not be queued")
+	assert_false(converter.is_running(), "nothing should be running for an up-to-date batch")
+
+	elapsed = 0.0
+	while not completed.has(second_batch) and elapsed < 5.0:
+		await Engine.get_main_loop().create_timer(0.1).timeout
+		elapsed += 0.1
+	assert_true(completed.has(second_batch), "second batch should complete")
+	if completed.has(second_batch):
+		assert_array_size(completed[second_batch], 1, "second batch should report its task")
+		assert_eq(completed[second_batch][0].error_message, "Output is up to date", "unchanged task should be skipped")
+	assert_false(started.has(second_task.id), "skipped task should not emit conversion_started")